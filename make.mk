@@ -15,7 +15,64 @@ else
   MKDIR = mkdir
 endif
 
-ifndef EMSCRIPTEN
+ifdef HOST
+# Native build for the fleet simulator: `make HOST=1` builds a program that runs many watches in one process.
+CFLAGS += -W -Wall -Wextra -Wmissing-prototypes -Wmissing-declarations
+CFLAGS += --std=gnu99 -O2 -pthread
+CFLAGS += -Wno-format -Wno-unused-parameter
+CFLAGS += -fdata-sections -ffunction-sections
+CFLAGS += -MD -MP -MT $(BUILD)/$(*F).o -MF $(BUILD)/$(@F).d
+
+LDFLAGS += -pthread
+LDFLAGS += -Wl,--gc-sections
+
+LIBS += -lm
+
+INCLUDES += \
+  -I$(TOP)/boards/$(BOARD) \
+  -I$(TOP)/watch-library/shared/driver/ \
+  -I$(TOP)/watch-library/shared/config/ \
+  -I$(TOP)/watch-library/shared/watch/ \
+  -I$(TOP)/watch-library/host/watch/ \
+  -I$(TOP)/watch-library/simulator/watch/ \
+  -I$(TOP)/watch-library/simulator/hpl/port/ \
+  -I$(TOP)/watch-library/hardware/include/component \
+  -I$(TOP)/watch-library/hardware/hal/include/ \
+  -I$(TOP)/watch-library/hardware/hal/utils/include/ \
+  -I$(TOP)/watch-library/hardware/hpl/slcd/ \
+  -I$(TOP)/watch-library/hardware/hw/ \
+
+SRCS += \
+  $(TOP)/watch-library/host/main.c \
+  $(TOP)/watch-library/host/watch/watch_host.c \
+  $(TOP)/watch-library/host/watch/watch_rtc.c \
+  $(TOP)/watch-library/host/watch/watch_slcd.c \
+  $(TOP)/watch-library/host/watch/watch_extint.c \
+  $(TOP)/watch-library/host/watch/watch_led.c \
+  $(TOP)/watch-library/host/watch/watch_buzzer.c \
+  $(TOP)/watch-library/simulator/watch/watch_adc.c \
+  $(TOP)/watch-library/simulator/watch/watch_gpio.c \
+  $(TOP)/watch-library/simulator/watch/watch_i2c.c \
+  $(TOP)/watch-library/simulator/watch/watch_spi.c \
+  $(TOP)/watch-library/simulator/watch/watch_spi_flash_model.c \
+  $(TOP)/watch-library/simulator/watch/watch_uart.c \
+  $(TOP)/watch-library/host/watch/watch_deepsleep.c \
+  $(TOP)/watch-library/host/watch/watch_private.c \
+  $(TOP)/watch-library/simulator/watch/watch.c \
+  $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
+  $(TOP)/watch-library/shared/watch/watch_private_deepsleep.c \
+  $(TOP)/watch-library/shared/watch/watch_private_display.c \
+  $(TOP)/watch-library/shared/watch/watch_utility.c \
+  $(TOP)/watch-library/shared/driver/thermistor_driver.c \
+  $(TOP)/watch-library/shared/driver/lis2dh.c \
+  $(TOP)/watch-library/shared/driver/lis2dw.c \
+  $(TOP)/watch-library/shared/driver/spiflash.c \
+
+DEFINES += \
+  -DWATCH_HOST \
+  -DWATCH_INSTANCE_LOCAL=__thread
+
+else ifndef EMSCRIPTEN
 CC = arm-none-eabi-gcc
 OBJCOPY = arm-none-eabi-objcopy
 SIZE = arm-none-eabi-size
@@ -118,9 +175,11 @@ SRCS += \
   $(TOP)/watch-library/hardware/hpl/slcd/hpl_slcd.c \
   $(TOP)/watch-library/hardware/hpl/systick/hpl_systick.c \
   $(TOP)/watch-library/shared/driver/thermistor_driver.c \
+  $(TOP)/watch-library/shared/driver/lis2dh.c \
   $(TOP)/watch-library/shared/driver/lis2dw.c \
   $(TOP)/watch-library/shared/driver/spiflash.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
+  $(TOP)/watch-library/shared/watch/watch_private_deepsleep.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
@@ -128,6 +187,19 @@ DEFINES += \
   -D__SAML22J18A__ \
   -DDONT_USE_CMSIS_INIT
 
+ifdef PROFILE
+SRCS += $(TOP)/watch-library/hardware/watch/watch_profile.c
+DEFINES += -DWATCH_WAKE_PROFILE
+endif
+
+# `make RAMFUNC=1` runs the functions marked WATCH_RAMFUNC from SRAM. It's off by default until it has been measured:
+# build the same firmware with PROFILE=1, once with RAMFUNC=1 and once without, run each on the same watch with
+# wake_profile_face for an hour, and compare the EVENT_TICK histograms a long press on ALARM prints. Only turn it
+# on by default if the wakes get shorter.
+ifdef RAMFUNC
+DEFINES += -DWATCH_RUN_FROM_RAM
+endif
+
 else
 
 CFLAGS += -W -Wall -Wextra -Wmissing-prototypes -Wmissing-declarations
@@ -157,13 +229,18 @@ SRCS += \
   $(TOP)/watch-library/simulator/watch/watch_gpio.c \
   $(TOP)/watch-library/simulator/watch/watch_i2c.c \
   $(TOP)/watch-library/simulator/watch/watch_spi.c \
+  $(TOP)/watch-library/simulator/watch/watch_spi_flash_model.c \
   $(TOP)/watch-library/simulator/watch/watch_uart.c \
   $(TOP)/watch-library/simulator/watch/watch_deepsleep.c \
   $(TOP)/watch-library/simulator/watch/watch_private.c \
   $(TOP)/watch-library/simulator/watch/watch.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
+  $(TOP)/watch-library/shared/watch/watch_private_deepsleep.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
+  $(TOP)/watch-library/shared/driver/thermistor_driver.c \
+  $(TOP)/watch-library/shared/driver/lis2dh.c \
+  $(TOP)/watch-library/shared/driver/lis2dw.c \
 
 endif
 
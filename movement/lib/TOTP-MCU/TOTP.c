@@ -1,10 +1,10 @@
 #include "TOTP.h"
 #include "sha1.h"
 
-uint8_t* _hmacKey;
-uint8_t _keyLength;
-uint8_t _timeZoneOffset;
-uint32_t _timeStep;
+WATCH_INSTANCE_LOCAL uint8_t* _hmacKey;
+WATCH_INSTANCE_LOCAL uint8_t _keyLength;
+WATCH_INSTANCE_LOCAL uint8_t _timeZoneOffset;
+WATCH_INSTANCE_LOCAL uint32_t _timeStep;
 
 // Init the library with the private key, its length and the timeStep duration
 void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep) {
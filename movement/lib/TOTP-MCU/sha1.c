@@ -14,19 +14,19 @@ uint8_t sha1InitState[] = {
   0xf0,0xe1,0xd2,0xc3  // H4
 };
 
-union _buffer {
+WATCH_INSTANCE_LOCAL union _buffer {
   uint8_t b[BLOCK_LENGTH];
   uint32_t w[BLOCK_LENGTH/4];
 } buffer;
-union _state {
+WATCH_INSTANCE_LOCAL union _state {
   uint8_t b[HASH_LENGTH];
   uint32_t w[HASH_LENGTH/4];
 } state;
 
-uint8_t bufferOffset;
-uint32_t byteCount;
-uint8_t keyBuffer[BLOCK_LENGTH];
-uint8_t innerHash[HASH_LENGTH];
+WATCH_INSTANCE_LOCAL uint8_t bufferOffset;
+WATCH_INSTANCE_LOCAL uint32_t byteCount;
+WATCH_INSTANCE_LOCAL uint8_t keyBuffer[BLOCK_LENGTH];
+WATCH_INSTANCE_LOCAL uint8_t innerHash[HASH_LENGTH];
 
 void init(void) {
   memcpy(state.b,sha1InitState,HASH_LENGTH);
@@ -6,6 +6,11 @@
 #define HASH_LENGTH 20
 #define BLOCK_LENGTH 64
 
+// hash state is per watch in the multi-watch host build; see watch.h.
+#ifndef WATCH_INSTANCE_LOCAL
+#define WATCH_INSTANCE_LOCAL
+#endif
+
 void init(void);
 void initHmac(const uint8_t* secret, uint8_t secretLength);
 uint8_t* result(void);
@@ -23,22 +23,43 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <limits.h>
 #include "watch.h"
+#include "watch_utility.h"
 #include "movement.h"
+// `make test` swaps in a config with every watch face in it.
+#ifdef MOVEMENT_TEST
+#include "movement_test_config.h"
+#else
 #include "movement_config.h"
+#endif
+#include "lis2dw.h"
 
 #if __EMSCRIPTEN__
 #include <emscripten.h>
+#define MOVEMENT_EXPORT EMSCRIPTEN_KEEPALIVE
+#else
+#define MOVEMENT_EXPORT
+#endif
+
+#ifdef WATCH_HOST
+#include "watch_host.h"
+// each watch in a host fleet runs its own selection of the faces built in, which app_init picks out of watch_faces.
+static WATCH_INSTANCE_LOCAL watch_face_t movement_faces[MOVEMENT_NUM_FACES];
+static WATCH_INSTANCE_LOCAL uint8_t movement_num_faces;
+#else
+#define movement_faces watch_faces
+#define movement_num_faces MOVEMENT_NUM_FACES
 #endif
 
-movement_state_t movement_state;
-void * watch_face_contexts[MOVEMENT_NUM_FACES];
-watch_date_time scheduled_tasks[MOVEMENT_NUM_FACES];
+WATCH_INSTANCE_LOCAL movement_state_t movement_state;
+WATCH_INSTANCE_LOCAL void * watch_face_contexts[MOVEMENT_NUM_FACES];
+WATCH_INSTANCE_LOCAL watch_date_time scheduled_tasks[MOVEMENT_NUM_FACES];
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 3600, 7200, 21600, 43200, 86400, 172800, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
-movement_event_t event;
+WATCH_INSTANCE_LOCAL movement_event_t event;
 
 const int16_t movement_timezone_offsets[] = {
     0,      //  0 :   0:00:00 (UTC)
@@ -95,11 +116,328 @@ void cb_alarm_fired(void);
 void cb_fast_tick(void);
 void cb_tick(void);
 
+// with a wrist raise to bring us back, there's no reason to stay awake long after the wearer looks away.
+#define MOVEMENT_WRIST_RAISE_LE_DEADLINE (30)
+// the 6D position that counts as looking at the watch: display up, i.e. gravity along +Z.
+#define MOVEMENT_WRIST_RAISE_POSITION LIS2DW_WAKE_UP_SRC_VAL_ZH
+
 static inline void _movement_reset_inactivity_countdown(void) {
     movement_state.le_mode_ticks = movement_le_inactivity_deadlines[movement_state.settings.bit.le_interval];
+    if (movement_state.settings.bit.wrist_raise_wake && movement_state.settings.bit.le_interval) movement_state.le_mode_ticks = MOVEMENT_WRIST_RAISE_LE_DEADLINE;
     movement_state.timeout_ticks = movement_timeout_inactivity_deadlines[movement_state.settings.bit.to_interval];
 }
 
+static void _movement_set_display_profile(watch_display_profile_t profile) {
+    if (movement_state.display_profile == profile) return;
+    watch_set_display_profile(profile);
+    movement_state.display_profile = profile;
+}
+
+// below 2.4 volts, the charge pump has to work noticeably harder to reach the normal LCD drive voltage.
+#define MOVEMENT_BATTERY_LOW_VOLTAGE (2400)
+// the regulator's low power efficiency mode needs VCC above 2.5V. the brownout detector turns it off at 2.6V on the
+// way down, and we only turn it back on with some margin, so it doesn't flap as the voltage wobbles.
+#define MOVEMENT_BATTERY_LPEFF_OFF_VOLTAGE (2600)
+#define MOVEMENT_BATTERY_LPEFF_ON_VOLTAGE (2700)
+
+// a rough discharge curve for a CR2016 under a light load, from millivolts to percent remaining.
+static const uint16_t movement_battery_curve[][2] = {
+    {2950, 100}, {2900, 90}, {2850, 75}, {2800, 55}, {2750, 40}, {2700, 30},
+    {2600, 20}, {2500, 12}, {2400, 7}, {2200, 2}, {2000, 0},
+};
+
+static void _movement_arm_brownout_detector(void) {
+    // sample once a second while the user is around, since the LED and buzzer can pull the battery down quickly;
+    // in low energy mode the voltage only drifts, and once a minute is plenty.
+    uint8_t sample_interval = (movement_state.le_mode_ticks == -1) ? 64 : 1;
+    if (movement_state.regulator_lpeff) {
+        // first stage: get out of low power efficiency mode before VCC drops under 2.5V.
+        watch_configure_brownout_detector(MOVEMENT_BATTERY_LPEFF_OFF_VOLTAGE, sample_interval);
+    } else if (!movement_state.battery_low) {
+        // second stage: flag the battery as low as soon as it gets there, rather than at the next hourly check.
+        watch_configure_brownout_detector(MOVEMENT_BATTERY_LOW_VOLTAGE, sample_interval);
+    } else {
+        // nothing left to watch for.
+        watch_configure_brownout_detector(0, 0);
+    }
+}
+
+// set when a battery check had to wait for a face that's sampling or scanning with the ADC; the next minute tries again.
+static WATCH_INSTANCE_LOCAL bool movement_battery_check_pending;
+
+static void _movement_update_battery(void) {
+    // enabling the ADC resets it and disabling it stops its clock, either of which would end the face's sampling
+    // without a callback.
+    movement_battery_check_pending = watch_adc_is_busy();
+    if (movement_battery_check_pending) return;
+
+    watch_enable_adc();
+    uint16_t voltage = watch_get_vcc_voltage();
+    watch_disable_adc();
+
+    movement_state.battery_voltage = voltage;
+    movement_state.battery_low = voltage < MOVEMENT_BATTERY_LOW_VOLTAGE;
+    if (voltage >= MOVEMENT_BATTERY_LPEFF_ON_VOLTAGE) movement_state.regulator_lpeff = true;
+    else if (voltage < MOVEMENT_BATTERY_LPEFF_OFF_VOLTAGE) movement_state.regulator_lpeff = false;
+    watch_set_regulator_low_power_efficiency(movement_state.regulator_lpeff);
+    _movement_arm_brownout_detector();
+}
+
+static WATCH_INSTANCE_LOCAL uint8_t movement_accelerometer_users;
+
+bool movement_claim_accelerometer(void) {
+    if (movement_accelerometer_users) {
+        movement_accelerometer_users++;
+        return true;
+    }
+
+    watch_enable_i2c();
+    if (!lis2dw_begin()) {
+        // no sensor board; don't leave SERCOM1 and its interrupt on for nothing.
+        watch_disable_i2c();
+        return false;
+    }
+
+    lis2dw_begin_configuration();
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_12_5_HZ);
+    lis2dw_set_low_power_mode(LIS2DW_LP_MODE_1);
+    lis2dw_set_range(LIS2DW_RANGE_2_G);
+    lis2dw_apply_configuration();
+    watch_enable_external_interrupts();
+    movement_accelerometer_users = 1;
+
+    return true;
+}
+
+void movement_release_accelerometer(void) {
+    if (!movement_accelerometer_users || --movement_accelerometer_users) return;
+
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_POWERDOWN);
+    watch_disable_i2c();
+}
+
+static WATCH_INSTANCE_LOCAL bool movement_wrist_raise_armed;
+static WATCH_INSTANCE_LOCAL bool movement_tap_enabled;
+static WATCH_INSTANCE_LOCAL uint8_t movement_activity_users;
+
+static void _movement_activity_log_wake_up(void);
+
+static void cb_accelerometer_event(const lis2dw_event_sources_t *sources) {
+    // 6D reports every change of position; we only wake for the one where the display turns up to face the wearer.
+    if (movement_wrist_raise_armed && (sources->sixd_src & LIS2DW_WAKE_UP_SRC_VAL_6D_IA) && (sources->sixd_src & MOVEMENT_WRIST_RAISE_POSITION)) {
+        _movement_reset_inactivity_countdown();
+    }
+    if (movement_activity_users && (sources->all_int_src & LIS2DW_REG_ALL_INT_SRC_WU_IA)) _movement_activity_log_wake_up();
+    if (movement_tap_enabled && (sources->all_int_src & (LIS2DW_REG_ALL_INT_SRC_SINGLE_TAP | LIS2DW_REG_ALL_INT_SRC_DOUBLE_TAP))) {
+        _movement_reset_inactivity_countdown();
+        // pressing a button can jolt the tap engine too; the button's own event wins.
+        if (event.event_type != EVENT_NONE) return;
+        event.event_type = (sources->all_int_src & LIS2DW_REG_ALL_INT_SRC_DOUBLE_TAP) ? EVENT_DOUBLE_TAP : EVENT_SINGLE_TAP;
+    }
+}
+
+// INT1 carries whichever events are wanted at the moment; the LIS2DW only has the one set of sources.
+static void _movement_route_accelerometer_events(void) {
+    uint8_t sources = 0;
+
+    if (movement_wrist_raise_armed) sources |= LIS2DW_CTRL4_INT1_6D;
+    if (movement_tap_enabled) sources |= LIS2DW_CTRL4_INT1_SINGLE_TAP | LIS2DW_CTRL4_INT1_TAP;
+    if (movement_activity_users) sources |= LIS2DW_CTRL4_INT1_WU;
+
+    if (sources) lis2dw_enable_events(MOVEMENT_ACCELEROMETER_INT1_PIN, sources, cb_accelerometer_event);
+    else lis2dw_disable_events();
+}
+
+static bool _movement_arm_wrist_raise(void) {
+    if (!movement_claim_accelerometer()) {
+        // nothing to wake us, so stop cutting low energy mode short.
+        movement_state.settings.bit.wrist_raise_wake = false;
+        watch_store_backup_data(movement_state.settings.reg, 0);
+        return false;
+    }
+    lis2dw_configure_6d(LIS2DW_TAP_THS_X_VAL_6D_THS_60);
+    movement_wrist_raise_armed = true;
+    _movement_route_accelerometer_events();
+    // INT1 goes through the EIC, which Sleep Mode would turn off.
+    movement_request_le_interrupts(true);
+
+    return true;
+}
+
+static void _movement_disarm_wrist_raise(void) {
+    movement_request_le_interrupts(false);
+    movement_wrist_raise_armed = false;
+    _movement_route_accelerometer_events();
+    movement_release_accelerometer();
+}
+
+// tap thresholds are in 1/32 of full scale, so 12 is 750 mg at ±2g. only Z counts: a tap lands on the crystal, while
+// the buttons push sideways. the durations are in units of the 200 Hz data rate: 80 ms of shock, 40 ms of quiet, and
+// up to 480 ms between the two taps of a double tap.
+#define MOVEMENT_TAP_THRESHOLD (12)
+#define MOVEMENT_TAP_SHOCK (2)
+#define MOVEMENT_TAP_QUIET (2)
+#define MOVEMENT_TAP_LATENCY (3)
+
+bool movement_enable_tap_detection(void) {
+    // taps go to whichever face is on screen, so there's only ever one user; the activate on the way out of low energy
+    // mode, which comes without a resign, just finds it already on.
+    if (movement_tap_enabled) return true;
+    if (!movement_claim_accelerometer()) return false;
+
+    // the tap engine works on the raw sample stream, and a tap is over in a few tens of milliseconds; 200 Hz is the
+    // fastest low power mode goes. the step counter can't keep up with that cheaply, so it sits this out.
+    _movement_step_counter_pause(true);
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_200_HZ);
+    lis2dw_configure_tap(LIS2DW_TAP_THS_Z_VAL_Z_EN, MOVEMENT_TAP_THRESHOLD, MOVEMENT_TAP_SHOCK, MOVEMENT_TAP_QUIET, MOVEMENT_TAP_LATENCY, true);
+    movement_tap_enabled = true;
+    _movement_route_accelerometer_events();
+    // INT1 goes through the EIC, which Sleep Mode would turn off, and a tap should wake us from low energy mode anyway.
+    movement_request_le_interrupts(true);
+
+    return true;
+}
+
+void movement_disable_tap_detection(void) {
+    if (!movement_tap_enabled) return;
+
+    movement_request_le_interrupts(false);
+    movement_tap_enabled = false;
+    _movement_route_accelerometer_events();
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_12_5_HZ);
+    _movement_step_counter_pause(false);
+    movement_release_accelerometer();
+}
+
+// the wake-up threshold is in 1/64 of full scale, so 2 is 62.5 mg of high-passed acceleration at ±2g: enough to ignore
+// breathing and sensor noise, not so much that a slow walk goes unnoticed. a single event can be the wrist settling,
+// so a minute needs two of them to count as active.
+#define MOVEMENT_ACTIVITY_WAKE_THRESHOLD (2)
+#define MOVEMENT_ACTIVITY_MINUTE_EVENTS (2)
+
+static WATCH_INSTANCE_LOCAL uint8_t movement_activity_log[(MOVEMENT_ACTIVITY_LOG_EPOCHS + 1) / 2];
+static WATCH_INSTANCE_LOCAL uint16_t movement_activity_head;            // index of the current epoch
+static WATCH_INSTANCE_LOCAL uint32_t movement_activity_epoch;           // the epoch (since the UNIX epoch) that the head is for
+static WATCH_INSTANCE_LOCAL uint16_t movement_activity_epochs_logged;   // 0 until the log first starts
+static WATCH_INSTANCE_LOCAL uint32_t movement_activity_minute;          // the minute that the event count is for
+static WATCH_INSTANCE_LOCAL uint8_t movement_activity_minute_events;
+static WATCH_INSTANCE_LOCAL bool movement_activity_masked;            // wake-up events are held off until the next minute
+
+static uint32_t _movement_current_minute(void) {
+    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0) / 60;
+}
+
+static uint8_t _movement_activity_get(uint16_t index) {
+    return (movement_activity_log[index / 2] >> ((index & 1) * 4)) & 0xF;
+}
+
+static void _movement_activity_set(uint16_t index, uint8_t value) {
+    uint8_t shift = (index & 1) * 4;
+
+    movement_activity_log[index / 2] = (movement_activity_log[index / 2] & ~(0xF << shift)) | (value << shift);
+}
+
+// like the step counter's bins, the epochs catch up on the time that's gone by whenever they're touched. if the clock
+// goes backwards, the current epoch just keeps filling until it catches up.
+static void _movement_activity_advance(uint32_t minute) {
+    uint32_t epoch = minute / MOVEMENT_ACTIVITY_EPOCH_MINUTES;
+    uint32_t elapsed;
+
+    if (epoch <= movement_activity_epoch) return;
+    elapsed = epoch - movement_activity_epoch;
+    if (elapsed > MOVEMENT_ACTIVITY_LOG_EPOCHS) elapsed = MOVEMENT_ACTIVITY_LOG_EPOCHS;
+    for (uint32_t i = 0; i < elapsed; i++) {
+        movement_activity_head = (movement_activity_head + 1) % MOVEMENT_ACTIVITY_LOG_EPOCHS;
+        _movement_activity_set(movement_activity_head, 0);
+    }
+    movement_activity_epochs_logged = (movement_activity_epochs_logged + elapsed > MOVEMENT_ACTIVITY_LOG_EPOCHS) ?
+                                      MOVEMENT_ACTIVITY_LOG_EPOCHS : movement_activity_epochs_logged + elapsed;
+    movement_activity_epoch = epoch;
+}
+
+static void _movement_activity_log_wake_up(void) {
+    uint32_t minute = _movement_current_minute();
+    uint8_t active_minutes;
+
+    if (minute != movement_activity_minute) {
+        movement_activity_minute = minute;
+        movement_activity_minute_events = 0;
+    }
+    // the mask takes a moment to reach the LIS2DW, so a straggler or two can still come in after the minute counts.
+    if (movement_activity_minute_events == UINT8_MAX || ++movement_activity_minute_events != MOVEMENT_ACTIVITY_MINUTE_EVENTS) return;
+
+    _movement_activity_advance(minute);
+    active_minutes = _movement_activity_get(movement_activity_head);
+    if (active_minutes < MOVEMENT_ACTIVITY_EPOCH_MINUTES) _movement_activity_set(movement_activity_head, active_minutes + 1);
+    // the rest of a busy minute can't change anything, so stop waking for it; the minute alarm lets them back in.
+    lis2dw_mask_events(LIS2DW_CTRL4_INT1_WU);
+    movement_activity_masked = true;
+}
+
+static void _movement_activity_log_unmask(void) {
+    if (!movement_activity_masked) return;
+    movement_activity_masked = false;
+    lis2dw_mask_events(0);
+}
+
+bool movement_enable_activity_log(void) {
+    if (movement_activity_users) {
+        movement_activity_users++;
+        return true;
+    }
+
+    if (!movement_claim_accelerometer()) return false;
+
+    if (movement_activity_epochs_logged) {
+        _movement_activity_advance(_movement_current_minute());
+    } else {
+        movement_activity_epoch = _movement_current_minute() / MOVEMENT_ACTIVITY_EPOCH_MINUTES;
+        movement_activity_epochs_logged = 1;
+    }
+    lis2dw_configure_wake_up(MOVEMENT_ACTIVITY_WAKE_THRESHOLD, 0);
+    _movement_activity_log_unmask();
+    movement_activity_users = 1;
+    _movement_route_accelerometer_events();
+    // wake-up events come in over the EIC, which Sleep Mode would turn off.
+    movement_request_le_interrupts(true);
+
+    return true;
+}
+
+void movement_disable_activity_log(void) {
+    if (!movement_activity_users || --movement_activity_users) return;
+
+    movement_request_le_interrupts(false);
+    _movement_activity_log_unmask();
+    _movement_route_accelerometer_events();
+    movement_release_accelerometer();
+}
+
+uint32_t movement_get_activity_epoch(void) {
+    return _movement_current_minute() / MOVEMENT_ACTIVITY_EPOCH_MINUTES;
+}
+
+uint8_t movement_get_activity(uint32_t now, uint16_t epochs_ago) {
+    // the log belongs to the interrupt, so rather than catching it up from here, work out where it would be.
+    uint32_t elapsed = (now > movement_activity_epoch) ? now - movement_activity_epoch : 0;
+
+    if (epochs_ago >= MOVEMENT_ACTIVITY_LOG_EPOCHS || epochs_ago < elapsed) return 0;
+    epochs_ago -= elapsed;
+    if (epochs_ago >= movement_activity_epochs_logged) return 0;
+
+    return _movement_activity_get((movement_activity_head + MOVEMENT_ACTIVITY_LOG_EPOCHS - epochs_ago) % MOVEMENT_ACTIVITY_LOG_EPOCHS);
+}
+
+uint16_t movement_get_activity_epochs_logged(void) {
+    uint32_t epoch = _movement_current_minute() / MOVEMENT_ACTIVITY_EPOCH_MINUTES;
+    uint32_t elapsed = (epoch > movement_activity_epoch) ? epoch - movement_activity_epoch : 0;
+
+    if (!movement_activity_epochs_logged) return 0;
+    if (movement_activity_epochs_logged + elapsed > MOVEMENT_ACTIVITY_LOG_EPOCHS) return MOVEMENT_ACTIVITY_LOG_EPOCHS;
+
+    return movement_activity_epochs_logged + elapsed;
+}
+
 static inline void _movement_enable_fast_tick_if_needed(void) {
     if (!movement_state.fast_tick_enabled) {
         movement_state.fast_ticks = 0;
@@ -117,12 +455,27 @@ static inline void _movement_disable_fast_tick_if_possible(void) {
 }
 
 static void _movement_handle_background_tasks(void) {
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+    // this runs once a minute, which starts a new minute for the activity log.
+    _movement_activity_log_unmask();
+    // it's also where the battery service does its hourly check. a brownout since the last one means the voltage has
+    // crossed a threshold, so check now.
+    if (watch_get_brownout_detected()) {
+        // if it was the LPEFF stage, SYSTEM_Handler has already turned LPEFF off. with whatever pulled VCC down gone,
+        // it often reads back in the 2.6-2.7V band, which mustn't count as still being on; it has to climb past
+        // MOVEMENT_BATTERY_LPEFF_ON_VOLTAGE to get LPEFF back.
+        movement_state.regulator_lpeff = false;
+        _movement_update_battery();
+    } else if (movement_battery_check_pending || watch_rtc_get_date_time().unit.minute == 0) {
+        _movement_update_battery();
+    }
+
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
         // For each face, if the watch face wants a background task...
-        if (watch_faces[i].wants_background_task != NULL && watch_faces[i].wants_background_task(&movement_state.settings, watch_face_contexts[i])) {
+        if (movement_faces[i].wants_background_task != NULL && movement_faces[i].wants_background_task(&movement_state.settings, watch_face_contexts[i])) {
             // ...we give it one. pretty straightforward!
             movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-            watch_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
+            watch_profile_set_event(EVENT_BACKGROUND_TASK, i);
+            movement_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
         }
     }
     movement_state.needs_background_tasks_handled = false;
@@ -132,12 +485,13 @@ static void _movement_handle_scheduled_tasks(void) {
     watch_date_time date_time = watch_rtc_get_date_time();
     uint8_t num_active_tasks = 0;
 
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
         if (scheduled_tasks[i].reg) {
             if (scheduled_tasks[i].reg == date_time.reg) {
                 scheduled_tasks[i].reg = 0;
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
+                watch_profile_set_event(EVENT_BACKGROUND_TASK, i);
+                movement_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
             } else {
                 num_active_tasks++;
             }
@@ -167,6 +521,11 @@ void movement_request_tick_frequency(uint8_t freq) {
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+void movement_request_le_interrupts(bool enabled) {
+    if (enabled) movement_state.le_interrupt_requests++;
+    else if (movement_state.le_interrupt_requests) movement_state.le_interrupt_requests--;
+}
+
 void movement_illuminate_led(void) {
     if (movement_state.settings.bit.led_duration) {
         watch_set_led_color(movement_state.settings.bit.led_red_color ? (0xF | movement_state.settings.bit.led_red_color << 4) : 0,
@@ -177,12 +536,13 @@ void movement_illuminate_led(void) {
 }
 
 void movement_move_to_face(uint8_t watch_face_index) {
+    if (watch_face_index >= movement_num_faces) watch_face_index = 0;
     movement_state.watch_face_changed = true;
     movement_state.next_watch_face = watch_face_index;
 }
 
 void movement_move_to_next_face(void) {
-    movement_move_to_face((movement_state.current_watch_face + 1) % MOVEMENT_NUM_FACES);
+    movement_move_to_face((movement_state.current_watch_face + 1) % movement_num_faces);
 }
 
 void movement_schedule_background_task(watch_date_time date_time) {
@@ -196,7 +556,7 @@ void movement_schedule_background_task(watch_date_time date_time) {
 void movement_cancel_background_task(void) {
     scheduled_tasks[movement_state.current_watch_face].reg = 0;
     bool other_tasks_scheduled = false;
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
         if (scheduled_tasks[i].reg != 0) {
             other_tasks_scheduled = true;
             break;
@@ -216,11 +576,181 @@ void movement_play_alarm(void) {
     _movement_enable_fast_tick_if_needed();
 }
 
+uint16_t movement_get_battery_voltage(void) {
+    return movement_state.battery_voltage;
+}
+
+uint8_t movement_get_battery_percent(void) {
+    uint16_t voltage = movement_state.battery_voltage;
+    const uint8_t count = sizeof(movement_battery_curve) / sizeof(movement_battery_curve[0]);
+    if (voltage >= movement_battery_curve[0][0]) return 100;
+    for(uint8_t i = 1; i < count; i++) {
+        if (voltage >= movement_battery_curve[i][0]) {
+            // interpolate between this point and the one above it.
+            uint16_t v0 = movement_battery_curve[i][0], v1 = movement_battery_curve[i - 1][0];
+            uint16_t p0 = movement_battery_curve[i][1], p1 = movement_battery_curve[i - 1][1];
+            return p0 + (uint32_t)(voltage - v0) * (p1 - p0) / (v1 - v0);
+        }
+    }
+    return 0;
+}
+
+bool movement_battery_is_low(void) {
+    return movement_state.battery_low;
+}
+
 uint8_t movement_claim_backup_register(void) {
     if (movement_state.next_available_backup_register >= 8) return 0;
     return movement_state.next_available_backup_register++;
 }
 
+#define MOVEMENT_SNAPSHOT_MAGIC (0x4D4F5653) // 'MOVS'
+#define MOVEMENT_SNAPSHOT_VERSION (6)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t num_faces;
+    uint32_t date_time;
+    uint32_t backup_registers[8];
+    uint32_t display_segments[3];
+    movement_state_t state;
+    movement_event_t event;
+    watch_date_time scheduled_tasks[MOVEMENT_NUM_FACES];
+    // the services' history. who's using them, and how the LIS2DW is set up for it, is live state and isn't saved.
+    movement_step_history_t step_history;
+    uint8_t activity_log[sizeof(movement_activity_log)];
+    uint16_t activity_head;
+    uint16_t activity_epochs_logged;
+    uint32_t activity_epoch;
+    uint32_t activity_minute;
+    uint8_t activity_minute_events;
+    uint32_t context_sizes[MOVEMENT_NUM_FACES];
+    // followed by each watch face's context, in order, per context_sizes.
+} movement_snapshot_header_t;
+
+static inline size_t _movement_snapshot_context_size(uint8_t face) {
+    return watch_face_contexts[face] == NULL ? 0 : movement_faces[face].context_size;
+}
+
+// like a face change in app_loop, but without the beep, and without touching the display.
+static void _movement_snapshot_resign(void) {
+    movement_faces[movement_state.current_watch_face].resign(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+    movement_disable_tap_detection();
+    movement_request_tick_frequency(1);
+}
+
+static void _movement_snapshot_activate(void) {
+    movement_faces[movement_state.current_watch_face].activate(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+    event.subsecond = 0;
+    event.event_type = EVENT_ACTIVATE;
+}
+
+MOVEMENT_EXPORT
+size_t movement_snapshot_size(void) {
+    size_t size = sizeof(movement_snapshot_header_t);
+    for(uint8_t i = 0; i < movement_num_faces; i++) size += _movement_snapshot_context_size(i);
+    return size;
+}
+
+MOVEMENT_EXPORT
+size_t movement_snapshot_save(uint8_t *buf, size_t length) {
+    size_t size = movement_snapshot_size();
+    if (buf == NULL || length < size) return 0;
+
+    // a save only copies state out; the face on screen carries on as it was. what it holds is sorted out on restore.
+    movement_snapshot_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MOVEMENT_SNAPSHOT_MAGIC;
+    header.version = MOVEMENT_SNAPSHOT_VERSION;
+    header.num_faces = movement_num_faces;
+    header.date_time = watch_rtc_get_date_time().reg;
+    for(uint8_t i = 0; i < 8; i++) header.backup_registers[i] = watch_get_backup_data(i);
+    watch_get_display_segments(header.display_segments);
+    header.state = movement_state;
+    header.event = event;
+    memcpy(header.scheduled_tasks, scheduled_tasks, sizeof(scheduled_tasks));
+    header.step_history = *_movement_step_counter_history();
+    memcpy(header.activity_log, movement_activity_log, sizeof(movement_activity_log));
+    header.activity_head = movement_activity_head;
+    header.activity_epochs_logged = movement_activity_epochs_logged;
+    header.activity_epoch = movement_activity_epoch;
+    header.activity_minute = movement_activity_minute;
+    header.activity_minute_events = movement_activity_minute_events;
+
+    uint8_t *contexts = buf + sizeof(header);
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
+        header.context_sizes[i] = _movement_snapshot_context_size(i);
+        memcpy(contexts, watch_face_contexts[i], header.context_sizes[i]);
+        contexts += header.context_sizes[i];
+    }
+    memcpy(buf, &header, sizeof(header));
+
+    return size;
+}
+
+MOVEMENT_EXPORT
+bool movement_snapshot_restore(const uint8_t *buf, size_t length) {
+    movement_snapshot_header_t header;
+    if (buf == NULL || length < sizeof(header)) return false;
+    memcpy(&header, buf, sizeof(header));
+
+    // validate everything before we touch any state.
+    if (header.magic != MOVEMENT_SNAPSHOT_MAGIC || header.version != MOVEMENT_SNAPSHOT_VERSION || header.num_faces != movement_num_faces) return false;
+    if (header.state.current_watch_face < 0 || header.state.current_watch_face >= (int16_t)movement_num_faces) return false;
+    size_t expected_length = sizeof(header);
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
+        if (header.context_sizes[i] != 0 && header.context_sizes[i] != movement_faces[i].context_size) return false;
+        expected_length += header.context_sizes[i];
+    }
+    if (length < expected_length) return false;
+
+    // the face on screen lets go of whatever it holds before its context is overwritten.
+    _movement_snapshot_resign();
+
+    const uint8_t *contexts = buf + sizeof(header);
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
+        if (header.context_sizes[i] == 0) continue;
+        if (watch_face_contexts[i] == NULL) watch_face_contexts[i] = malloc(header.context_sizes[i]);
+        memcpy(watch_face_contexts[i], contexts, header.context_sizes[i]);
+        contexts += header.context_sizes[i];
+    }
+
+    // LE interrupt requests are counts of claims held in this session, by services that keep running across the restore.
+    uint8_t le_interrupt_requests = movement_state.le_interrupt_requests;
+    movement_state = header.state;
+    movement_state.le_interrupt_requests = le_interrupt_requests;
+    event = header.event;
+    memcpy(scheduled_tasks, header.scheduled_tasks, sizeof(scheduled_tasks));
+    *_movement_step_counter_history() = header.step_history;
+    memcpy(movement_activity_log, header.activity_log, sizeof(movement_activity_log));
+    movement_activity_head = header.activity_head;
+    movement_activity_epochs_logged = header.activity_epochs_logged;
+    movement_activity_epoch = header.activity_epoch;
+    movement_activity_minute = header.activity_minute;
+    movement_activity_minute_events = header.activity_minute_events;
+    for(uint8_t i = 0; i < 8; i++) watch_store_backup_data(header.backup_registers[i], i);
+    watch_date_time date_time;
+    date_time.reg = header.date_time;
+    watch_rtc_set_date_time(date_time);
+    watch_set_display_segments(header.display_segments);
+    watch_set_display_profile(movement_state.display_profile);
+    watch_set_regulator_low_power_efficiency(movement_state.regulator_lpeff);
+    _movement_arm_brownout_detector();
+
+    // bring the RTC callbacks in line with the restored state.
+    uint8_t subsecond = movement_state.subsecond;
+    movement_request_tick_frequency(movement_state.tick_frequency);
+    movement_state.subsecond = subsecond;
+    movement_state.fast_tick_enabled = false;
+    if (movement_state.light_ticks != -1 || movement_state.alarm_ticks != -1) _movement_enable_fast_tick_if_needed();
+    else watch_rtc_disable_periodic_callback(128);
+
+    _movement_snapshot_activate();
+
+    return true;
+}
+
 void app_init(void) {
     memset(&movement_state, 0, sizeof(movement_state));
 
@@ -233,6 +763,20 @@ void app_init(void) {
     movement_state.next_available_backup_register = 4;
     _movement_reset_inactivity_countdown();
 
+#ifdef WATCH_HOST
+    const watch_host_config_t *host_config = watch_host_get_config();
+    movement_num_faces = 0;
+    for (uint8_t i = 0; i < host_config->num_faces; i++) {
+        if (host_config->faces[i] < MOVEMENT_NUM_FACES) movement_faces[movement_num_faces++] = watch_faces[host_config->faces[i]];
+    }
+    if (movement_num_faces == 0) {
+        memcpy(movement_faces, watch_faces, sizeof(watch_faces));
+        movement_num_faces = MOVEMENT_NUM_FACES;
+    }
+    if (host_config->first_face < movement_num_faces) movement_state.current_watch_face = host_config->first_face;
+    if (host_config->settings) movement_state.settings.reg = host_config->settings;
+#endif
+
 #if __EMSCRIPTEN__
     int32_t time_zone_offset = EM_ASM_INT({
         return -new Date().getTimezoneOffset();
@@ -246,6 +790,15 @@ void app_init(void) {
 #endif
 }
 
+#ifdef WATCH_HOST
+void app_host_finish(void) {
+    for(uint8_t i = 0; i < movement_num_faces; i++) {
+        free(watch_face_contexts[i]);
+        watch_face_contexts[i] = NULL;
+    }
+}
+#endif
+
 void app_wake_from_backup(void) {
     movement_state.settings.reg = watch_get_backup_data(0);
 }
@@ -253,10 +806,10 @@ void app_wake_from_backup(void) {
 void app_setup(void) {
     watch_store_backup_data(movement_state.settings.reg, 0);
 
-    static bool is_first_launch = true;
+    static WATCH_INSTANCE_LOCAL bool is_first_launch = true;
 
     if (is_first_launch) {
-        for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        for(uint8_t i = 0; i < movement_num_faces; i++) {
             watch_face_contexts[i] = NULL;
             scheduled_tasks[i].reg = 0;
             is_first_launch = false;
@@ -267,6 +820,10 @@ void app_setup(void) {
         alarm_time.reg = 0;
         alarm_time.unit.second = 59; // after a match, the alarm fires at the next rising edge of CLK_RTC_CNT, so 59 seconds lets us update at :00
         watch_rtc_register_alarm_callback(cb_alarm_fired, alarm_time, ALARM_MATCH_SS);
+
+        // like _watch_init, only turn on low power efficiency mode if the first reading is comfortably high.
+        movement_state.regulator_lpeff = false;
+        _movement_update_battery();
     }
     if (movement_state.le_mode_ticks != -1) {
         watch_disable_extwake_interrupt(BTN_ALARM);
@@ -279,14 +836,18 @@ void app_setup(void) {
         watch_enable_buzzer();
         watch_enable_leds();
         watch_enable_display();
+        // enabling the display resets it to the normal profile.
+        movement_state.display_profile = WATCH_DISPLAY_PROFILE_NORMAL;
+        // we're out of low energy mode (or just starting up), so watch the battery more closely.
+        _movement_arm_brownout_detector();
 
         movement_request_tick_frequency(1);
 
-        for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-            watch_faces[i].setup(&movement_state.settings, i, &watch_face_contexts[i]);
+        for(uint8_t i = 0; i < movement_num_faces; i++) {
+            movement_faces[i].setup(&movement_state.settings, i, &watch_face_contexts[i]);
         }
 
-        watch_faces[movement_state.current_watch_face].activate(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        movement_faces[movement_state.current_watch_face].activate(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
         event.subsecond = 0;
         event.event_type = EVENT_ACTIVATE;
     }
@@ -304,11 +865,13 @@ bool app_loop(void) {
             // low note for nonzero case, high note for return to watch_face 0
             watch_buzzer_play_note(movement_state.next_watch_face ? BUZZER_NOTE_C7 : BUZZER_NOTE_C8, 50);
         }
-        watch_faces[movement_state.current_watch_face].resign(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        movement_faces[movement_state.current_watch_face].resign(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        // tap detection belongs to the face that turned it on.
+        movement_disable_tap_detection();
         movement_state.current_watch_face = movement_state.next_watch_face;
         watch_clear_display();
         movement_request_tick_frequency(1);
-        watch_faces[movement_state.current_watch_face].activate(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        movement_faces[movement_state.current_watch_face].activate(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
         event.subsecond = 0;
         event.event_type = EVENT_ACTIVATE;
         movement_state.watch_face_changed = false;
@@ -338,6 +901,11 @@ bool app_loop(void) {
         watch_register_extwake_callback(BTN_ALARM, cb_alarm_btn_extwake, true);
         event.event_type = EVENT_NONE;
         event.subsecond = 0;
+        // nobody's looking; drive the display as gently as we can, and sample the battery less often, until someone wakes us.
+        _movement_set_display_profile(WATCH_DISPLAY_PROFILE_LOW_POWER);
+        _movement_arm_brownout_detector();
+        bool wrist_raise_armed = movement_state.settings.bit.wrist_raise_wake && _movement_arm_wrist_raise();
+        bool slept = false;
 
         // this is a little mini-runloop.
         // as long as le_mode_ticks is -1 (i.e. we are in low energy mode), we wake up here, update the screen, and go right back to sleep.
@@ -346,21 +914,53 @@ bool app_loop(void) {
             if (movement_state.needs_background_tasks_handled) _movement_handle_background_tasks();
 
             event.event_type = EVENT_LOW_ENERGY_UPDATE;
-            watch_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
-            watch_enter_sleep_mode();
+            watch_profile_set_event(event.event_type, movement_state.current_watch_face);
+            movement_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+
+            // the minute alarm is our next wake. if it's due so soon that rebuilding the peripherals would cost more
+            // than tearing them down saves, just wait for it in STANDBY. the RTC can't say how far into this second
+            // we are, so take the shortest the gap could be. with app_setup's default 5 ms, that's only ever the case
+            // at :59; any earlier, the gap is a second or more, and STANDBY only wins if app_setup takes over 62 ms.
+            uint32_t ms_until_alarm = (59 - watch_rtc_get_date_time().unit.second) * 1000;
+            if (!movement_state.le_interrupt_requests && watch_choose_sleep_level(ms_until_alarm, false, true) == WATCH_SLEEP_LEVEL_SLEEP_MODE) {
+                watch_enter_sleep_mode();
+                slept = true;
+            } else {
+                watch_rtc_disable_all_periodic_callbacks();
+                watch_enter_standby_mode();
+                // a watch face's interrupt can wake us too, but its callback has already done the work. unless the
+                // minute alarm or a button woke us, let any transfer it started finish and go straight back to sleep.
+                while (movement_state.le_interrupt_requests && movement_state.le_mode_ticks == -1 && !movement_state.needs_background_tasks_handled) {
+                    watch_i2c_wait();
+                    watch_enter_standby_mode();
+                }
+            }
         }
         // as soon as le_mode_ticks is reset by the extwake handler, we bail out of the loop and reactivate ourselves.
+        if (wrist_raise_armed) _movement_disarm_wrist_raise();
         event.event_type = EVENT_ACTIVATE;
         // this is a hack tho: waking from sleep mode, app_setup does get called, but it happens before we have reset our ticks.
         // need to figure out if there's a better heuristic for determining how we woke up.
         app_setup();
+        // Sleep Mode turned the I2C bus off and reset the EIC, which took the accelerometer's INT1 handler with it.
+        // app_setup brought the EIC back; whoever still holds a claim on the accelerometer needs the rest.
+        if (slept && movement_accelerometer_users) {
+            watch_enable_i2c();
+            _movement_route_accelerometer_events();
+        }
     }
 
-    static bool can_sleep = true;
+    static WATCH_INSTANCE_LOCAL bool can_sleep = true;
+
+    // on a low battery we idle in the low power display profile, but give the user the normal one while they interact.
+    if (event.event_type >= EVENT_LIGHT_BUTTON_DOWN && event.event_type <= EVENT_DOUBLE_TAP) {
+        _movement_set_display_profile(WATCH_DISPLAY_PROFILE_NORMAL);
+    }
 
     if (event.event_type) {
         event.subsecond = movement_state.subsecond;
-        can_sleep = watch_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        watch_profile_set_event(event.event_type, movement_state.current_watch_face);
+        can_sleep = movement_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
         // escape hatch: a watch face may not resign on EVENT_MODE_BUTTON_DOWN. In that case, a long press of MODE should let them out.
         if (event.event_type == EVENT_MODE_LONG_PRESS) {
             movement_move_to_next_face();
@@ -372,12 +972,14 @@ bool app_loop(void) {
     // if we have timed out of our timeout countdown, give the app a hint that they can resign.
     if (movement_state.timeout_ticks == 0) {
         movement_state.timeout_ticks = -1;
+        if (movement_state.battery_low) _movement_set_display_profile(WATCH_DISPLAY_PROFILE_LOW_POWER);
         if (movement_state.settings.bit.to_always == false) {
             // if "timeout always" is false, give the current watch face a chance to exit gracefully...
             event.event_type = EVENT_TIMEOUT;
         }
         event.subsecond = movement_state.subsecond;
-        watch_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        watch_profile_set_event(event.event_type, movement_state.current_watch_face);
+        movement_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
         event.event_type = EVENT_NONE;
         if (movement_state.settings.bit.to_always && movement_state.current_watch_face != 0) {
             // ...but if the user has "timeout always" set, give it the boot.
@@ -404,7 +1006,14 @@ bool app_loop(void) {
 
     event.subsecond = 0;
 
-    return can_sleep && (movement_state.light_ticks == -1) && !movement_state.is_buzzing;
+    if (!can_sleep) return false;
+    if (movement_state.light_ticks == -1 && !movement_state.is_buzzing && !watch_i2c_is_busy() && !watch_spi_is_busy()) return true;
+
+    // the LED, buzzer or an I2C or SPI transfer needs the main clock, so we can't go to STANDBY; but nothing happens until the
+    // next fast tick or bus interrupt, so wait for it in IDLE rather than spinning on app_loop at full current.
+    watch_enter_idle_mode();
+
+    return false;
 }
 
 static movement_event_type_t _figure_out_button_event(bool pin_level, movement_event_type_t button_down_event_type, uint8_t *down_timestamp) {
@@ -457,7 +1066,7 @@ void cb_alarm_fired(void) {
     movement_state.needs_background_tasks_handled = true;
 }
 
-void cb_fast_tick(void) {
+WATCH_RAMFUNC void cb_fast_tick(void) {
     movement_state.fast_ticks++;
     if (movement_state.light_ticks > 0) movement_state.light_ticks--;
     if (movement_state.alarm_ticks > 0) movement_state.alarm_ticks--;
@@ -466,7 +1075,7 @@ void cb_fast_tick(void) {
     if (movement_state.fast_ticks >= 1280) watch_rtc_disable_periodic_callback(128);
 }
 
-void cb_tick(void) {
+WATCH_RAMFUNC void cb_tick(void) {
     event.event_type = EVENT_TICK;
     watch_date_time date_time = watch_rtc_get_date_time();
     if (date_time.unit.second != movement_state.last_second) {
@@ -61,7 +61,8 @@ typedef union {
         // altimeter to display feet or meters as easily as it tells a thermometer to display degrees in F or C.
         bool clock_mode_24h : 1;            // indicates whether clock should use 12 or 24 hour mode.
         bool use_imperial_units : 1;        // indicates whether to use metric units (the default) or imperial.
-        uint8_t reserved : 7;               // room for more preferences if needed.
+        bool wrist_raise_wake : 1;          // if true, raising the wrist wakes the watch from low energy mode, which then engages much sooner.
+        uint8_t reserved : 6;               // room for more preferences if needed.
     } bit;
     uint32_t reg;
 } movement_settings_t;
@@ -116,6 +117,8 @@ typedef enum {
     EVENT_ALARM_BUTTON_DOWN,    // The alarm button has been pressed, but not yet released.
     EVENT_ALARM_BUTTON_UP,      // The alarm button was pressed and released.
     EVENT_ALARM_LONG_PRESS,     // The alarm button was held for >2 seconds, and released.
+    EVENT_SINGLE_TAP,           // The watch was tapped, if you called movement_enable_tap_detection.
+    EVENT_DOUBLE_TAP,           // The watch was tapped twice in quick succession. The first tap also arrives as EVENT_SINGLE_TAP.
 } movement_event_type_t;
 
 typedef struct {
@@ -229,6 +232,7 @@ typedef struct {
     watch_face_loop loop;
     watch_face_resign resign;
     watch_face_wants_background_task wants_background_task;
+    size_t context_size;    // the size of the context allocated in setup, or 0 if none; used for snapshots.
 } watch_face_t;
 
 typedef struct {
@@ -260,10 +264,19 @@ typedef struct {
 
     // low energy mode countdown
     int32_t le_mode_ticks;
+    uint8_t le_interrupt_requests;
 
     // app resignation countdown (TODO: consolidate with LE countdown?)
     int16_t timeout_ticks;
 
+    // display power management
+    watch_display_profile_t display_profile;
+
+    // battery service
+    uint16_t battery_voltage;
+    bool battery_low;
+    bool regulator_lpeff;
+
     // stuff for subsecond tracking
     uint8_t tick_frequency;
     uint8_t last_second;
@@ -279,6 +292,12 @@ void movement_illuminate_led(void);
 
 void movement_request_tick_frequency(uint8_t freq);
 
+// Low energy mode normally sleeps in Sleep Mode, which turns off the external interrupt controller, I2C and the
+// pins. A watch face that counts sensor interrupts can request that they keep working there instead; the watch then
+// waits in STANDBY, which costs more, and its interrupt callbacks run without waking the face. Requests are counted,
+// so request false again on resign.
+void movement_request_le_interrupts(bool enabled);
+
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
 void movement_schedule_background_task(watch_date_time date_time);
@@ -290,6 +309,90 @@ void movement_cancel_background_task(void);
 void movement_play_signal(void);
 void movement_play_alarm(void);
 
+// Movement measures the battery once an hour, and again whenever the brownout detector trips, so watch faces
+// should read these cached values rather than waking the ADC themselves.
+// returns the battery voltage in millivolts.
+uint16_t movement_get_battery_voltage(void);
+// returns a rough estimate of the charge left in the battery, from 0 to 100 percent.
+uint8_t movement_get_battery_percent(void);
+// returns true when the battery is low enough that the watch should cut back.
+bool movement_battery_is_low(void);
+
+// Movement's accelerometer services share the LIS2DW, with INT1 on A3. The first claim turns on the I2C bus and brings
+// the sensor up at 12.5 Hz in low power mode; the last release powers it down and turns the bus off again. A claim
+// returns false, and leaves the bus off, if there's no LIS2DW on it.
+#define MOVEMENT_ACCELEROMETER_INT1_PIN A3
+bool movement_claim_accelerometer(void);
+void movement_release_accelerometer(void);
+
+// The step counter runs the LIS2DW at 12.5 Hz in low power mode and counts steps from each batch of its FIFO with a
+// fixed-point detector, so the watch only wakes every couple of seconds. It keeps running in low energy mode. While a
+// face has tap detection on, the accelerometer runs at 200 Hz, and the step counter pauses rather than wake sixteen
+// times as often; steps taken in the meantime aren't counted.
+#define MOVEMENT_STEP_COUNTER_MINUTES (60)
+// starts counting; returns false if there's no LIS2DW on the bus. enables and disables are counted, like the LE
+// interrupt request, so call it once: in setup when the context is first allocated, or from activate behind a flag in
+// your state, since activate runs again on the way out of low energy mode without a resign.
+bool movement_enable_step_counter(void);
+// stops counting and powers the accelerometer down once the last user is gone.
+void movement_disable_step_counter(void);
+// returns the number of steps counted since the step counter was first enabled.
+uint32_t movement_get_step_count(void);
+// returns the steps counted in a recent minute: 0 is the current minute, up to MOVEMENT_STEP_COUNTER_MINUTES - 1.
+// each minute saturates at 255, which is well over anyone's cadence.
+uint8_t movement_get_steps_in_minute(uint8_t minutes_ago);
+// for Movement itself: stops and restarts the step counter's FIFO stream around tap detection.
+void _movement_step_counter_pause(bool paused);
+// for Movement's snapshots: the step counter's history, which lives in movement_step_counter.c.
+typedef struct {
+    uint32_t count;
+    uint32_t bin_minute;    // the minute (since the UNIX epoch) that the head bin is for
+    uint8_t bins[MOVEMENT_STEP_COUNTER_MINUTES];
+    uint8_t bin_head;       // index of the current minute's bin
+} movement_step_history_t;
+movement_step_history_t *_movement_step_counter_history(void);
+
+// Tap detection runs entirely in the LIS2DW's tap engine, which sends EVENT_SINGLE_TAP and EVENT_DOUBLE_TAP to the
+// current face. The engine needs the accelerometer at 200 Hz, which costs tens of microamps, so it belongs to the face
+// on screen: enable it on activate (calling it again is harmless), and Movement turns it off when that face resigns.
+// It keeps INT1 running in low energy mode, where a tap wakes the watch. Returns false if there's no LIS2DW on the bus.
+bool movement_enable_tap_detection(void);
+void movement_disable_tap_detection(void);
+
+// The activity log counts the LIS2DW's wake-up events, so nothing samples the accelerometer on our side and the watch
+// only wakes when the wrist moves. A minute with a couple of events counts as active, and the log keeps the number of
+// active minutes (0-15) in each 15 minute epoch, packed two to a byte, for four weeks. It keeps running in low energy
+// mode. Once a minute counts as active, wake-up events are held off until the next one, so a busy minute costs two
+// wakes rather than one per movement. Enables and disables are counted; the log itself survives being disabled, and
+// reads as still in the meantime.
+#define MOVEMENT_ACTIVITY_EPOCH_MINUTES (15)
+#define MOVEMENT_ACTIVITY_LOG_EPOCHS (28 * 24 * 60 / MOVEMENT_ACTIVITY_EPOCH_MINUTES)
+// starts logging; returns false if there's no LIS2DW on the bus. a face that logs in the background calls it in setup.
+bool movement_enable_activity_log(void);
+void movement_disable_activity_log(void);
+// returns the current epoch, counted from the UNIX epoch. it reads the RTC, so read it once and pass it in to
+// movement_get_activity for as many epochs as you want to look at.
+uint32_t movement_get_activity_epoch(void);
+// returns the active minutes in an epoch: 0 is the epoch now, up to MOVEMENT_ACTIVITY_LOG_EPOCHS - 1. epochs from
+// before the log started read as 0.
+uint8_t movement_get_activity(uint32_t now, uint16_t epochs_ago);
+// returns how many epochs the log covers, counting the current one.
+uint16_t movement_get_activity_epochs_logged(void);
+
 uint8_t movement_claim_backup_register(void);
 
+// Snapshots capture Movement's state, every watch face's context, scheduled tasks, the backup registers, the RTC
+// time, the contents of the display, and the step counter's and activity log's history, so that a session can be
+// restored later in the same build. Contexts are restored byte for byte, so any pointers inside them are only
+// meaningful within the same process.
+// What's left out is who holds what right now: accelerometer claims, tap detection, which services are enabled,
+// LE interrupt requests and the LIS2DW's configuration carry on from the live session. Saving leaves the watch as it
+// was. To keep faces' claims from leaking across a restore, the face on screen is resigned before it, and the restored
+// face is activated after it, with EVENT_ACTIVATE pending.
+size_t movement_snapshot_size(void);
+// returns the number of bytes written to buf, or 0 if buf is too small.
+size_t movement_snapshot_save(uint8_t *buf, size_t length);
+// returns false, without changing anything, if the snapshot doesn't match this build's faces and context sizes.
+bool movement_snapshot_restore(const uint8_t *buf, size_t length);
+
 #endif // MOVEMENT_H_
@@ -47,6 +47,10 @@
 #include "moon_phase_face.h"
 #include "orrery_face.h"
 #include "astronomy_face.h"
+#include "wake_profile_face.h"
+#include "activity_log_face.h"
+#include "level_face.h"
+#include "counter_face.h"
 // New includes go above this line.
 
 #endif // MOVEMENT_FACES_H_
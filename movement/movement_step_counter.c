@@ -0,0 +1,206 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_utility.h"
+#include "movement.h"
+#include "lis2dw.h"
+
+// at 12.5 Hz, a batch of 30 samples wakes us every 2.4 seconds, and leaves the FIFO two samples of slack.
+#define STEP_COUNTER_FIFO_THRESHOLD (30)
+
+// in low power mode 1 the samples are 12 bits, left justified; at ±2g, shifting out the padding leaves about 1 mg/LSB.
+#define STEP_COUNTER_SAMPLE_SHIFT (4)
+// the baseline tracks gravity with a time constant of 2^4 samples (about 1.3 seconds).
+#define STEP_COUNTER_BASELINE_SHIFT (4)
+// a step is a swing above the upper threshold after the signal has come back down below the lower one, in mg.
+#define STEP_COUNTER_PEAK_THRESHOLD (96)
+#define STEP_COUNTER_REARM_THRESHOLD (32)
+// peaks closer together than 0.24 seconds are bounces of the same step. once they're more than 2 seconds apart,
+// we've stopped walking; a lone peak doesn't count until a second one follows it.
+#define STEP_COUNTER_MIN_INTERVAL (3)
+#define STEP_COUNTER_MAX_INTERVAL (25)
+
+typedef struct {
+    int32_t baseline;           // magnitude of gravity in mg, shifted left by STEP_COUNTER_BASELINE_SHIFT
+    int16_t last_delta;         // the previous sample's departure from the baseline, in mg
+    uint8_t samples_since_peak; // saturates at 255
+    bool armed;                 // the signal has dropped below the rearm threshold since the last peak
+    bool step_pending;          // a peak that starts a new run; it's counted once a second peak confirms it
+} step_detector_t;
+
+static WATCH_INSTANCE_LOCAL uint8_t step_counter_users;
+static WATCH_INSTANCE_LOCAL lis2dw_fifo_t step_counter_fifo;
+static WATCH_INSTANCE_LOCAL step_detector_t step_detector;
+static WATCH_INSTANCE_LOCAL bool step_counter_paused;
+static WATCH_INSTANCE_LOCAL movement_step_history_t step_history;
+
+static uint32_t _movement_step_counter_current_minute(void) {
+    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0) / 60;
+}
+
+// rather than needing a tick every minute, the bins catch up on the minutes that have gone by whenever they're touched.
+static void _movement_step_counter_advance_bins(void) {
+    uint32_t minute = _movement_step_counter_current_minute();
+    uint32_t elapsed = minute - step_history.bin_minute;
+
+    if (minute < step_history.bin_minute) {
+        // the clock went backwards; start the new timeline from here.
+        elapsed = MOVEMENT_STEP_COUNTER_MINUTES;
+    }
+    if (elapsed >= MOVEMENT_STEP_COUNTER_MINUTES) {
+        memset(step_history.bins, 0, sizeof(step_history.bins));
+    } else {
+        for (uint32_t i = 0; i < elapsed; i++) {
+            step_history.bin_head = (step_history.bin_head + 1) % MOVEMENT_STEP_COUNTER_MINUTES;
+            step_history.bins[step_history.bin_head] = 0;
+        }
+    }
+    step_history.bin_minute = minute;
+}
+
+// cheap stand-in for sqrt(x² + y² + z²): the largest axis plus 3/8 of the other two is within 4% of it.
+static int16_t _movement_step_counter_magnitude(const lis2dw_reading_t *reading) {
+    int16_t a = abs(reading->x >> STEP_COUNTER_SAMPLE_SHIFT);
+    int16_t b = abs(reading->y >> STEP_COUNTER_SAMPLE_SHIFT);
+    int16_t c = abs(reading->z >> STEP_COUNTER_SAMPLE_SHIFT);
+    int16_t t;
+
+    if (a < b) { t = a; a = b; b = t; }
+    if (a < c) { t = a; a = c; c = t; }
+
+    return a + (((b + c) * 3) >> 3);
+}
+
+// returns the number of steps this sample completes: usually 0, sometimes 1, and 2 when it confirms a new run.
+static uint8_t _movement_step_counter_process(const lis2dw_reading_t *reading) {
+    step_detector_t *detector = &step_detector;
+    int16_t magnitude = _movement_step_counter_magnitude(reading);
+    int16_t delta, smoothed;
+    uint8_t steps = 0;
+
+    // start the baseline at the first sample, rather than having it climb up from zero through a fake step.
+    if (detector->baseline == 0) detector->baseline = (int32_t)magnitude << STEP_COUNTER_BASELINE_SHIFT;
+    // a one-pole high pass removes gravity, and averaging adjacent samples takes the edge off the sensor noise.
+    detector->baseline += magnitude - (detector->baseline >> STEP_COUNTER_BASELINE_SHIFT);
+    delta = magnitude - (detector->baseline >> STEP_COUNTER_BASELINE_SHIFT);
+    smoothed = (delta + detector->last_delta) / 2;
+    detector->last_delta = delta;
+
+    if (detector->samples_since_peak < UINT8_MAX) detector->samples_since_peak++;
+
+    if (!detector->armed) {
+        if (smoothed < STEP_COUNTER_REARM_THRESHOLD) detector->armed = true;
+        return 0;
+    }
+    if (smoothed < STEP_COUNTER_PEAK_THRESHOLD || detector->samples_since_peak < STEP_COUNTER_MIN_INTERVAL) return 0;
+
+    if (detector->samples_since_peak > STEP_COUNTER_MAX_INTERVAL) {
+        detector->step_pending = true;
+    } else {
+        steps = detector->step_pending ? 2 : 1;
+        detector->step_pending = false;
+    }
+    detector->armed = false;
+    detector->samples_since_peak = 0;
+
+    return steps;
+}
+
+static void _movement_step_counter_fifo_ready(const lis2dw_fifo_t *fifo, bool overrun) {
+    uint16_t steps = 0;
+
+    // if we fell behind and lost samples, treat the gap like the end of a run.
+    if (overrun) step_detector.samples_since_peak = UINT8_MAX;
+    // the samples are used where they landed; nothing is copied out of the FIFO buffer.
+    for (uint8_t i = 0; i < fifo->count; i++) steps += _movement_step_counter_process(&fifo->readings[i]);
+    if (!steps) return;
+
+    _movement_step_counter_advance_bins();
+    step_history.count += steps;
+    step_history.bins[step_history.bin_head] = (step_history.bins[step_history.bin_head] + steps > UINT8_MAX) ? UINT8_MAX : step_history.bins[step_history.bin_head] + steps;
+}
+
+bool movement_enable_step_counter(void) {
+    if (step_counter_users) {
+        step_counter_users++;
+        return true;
+    }
+
+    if (!movement_claim_accelerometer()) return false;
+
+    memset(&step_detector, 0, sizeof(step_detector));
+    step_detector.samples_since_peak = UINT8_MAX;
+
+    if (!step_counter_paused) lis2dw_start_fifo_stream(MOVEMENT_ACCELEROMETER_INT1_PIN, STEP_COUNTER_FIFO_THRESHOLD, &step_counter_fifo, _movement_step_counter_fifo_ready);
+    // the FIFO interrupt has to keep coming in low energy mode, or we'd stop counting as soon as the wrist goes down.
+    movement_request_le_interrupts(true);
+    step_counter_users = 1;
+
+    return true;
+}
+
+void movement_disable_step_counter(void) {
+    if (!step_counter_users || --step_counter_users) return;
+
+    movement_request_le_interrupts(false);
+    lis2dw_stop_fifo_stream();
+    movement_release_accelerometer();
+}
+
+// at the tap engine's 200 Hz, the watermark would come around every 150 ms, sixteen times as often as the detector
+// needs; rather than wake for samples we'd throw away, we stop counting while a face has taps on.
+void _movement_step_counter_pause(bool paused) {
+    if (paused == step_counter_paused) return;
+    step_counter_paused = paused;
+    if (!step_counter_users) return;
+
+    if (paused) {
+        lis2dw_stop_fifo_stream();
+    } else {
+        // the gap ends whatever run we were in, like an overrun does.
+        step_detector.samples_since_peak = UINT8_MAX;
+        lis2dw_start_fifo_stream(MOVEMENT_ACCELEROMETER_INT1_PIN, STEP_COUNTER_FIFO_THRESHOLD, &step_counter_fifo, _movement_step_counter_fifo_ready);
+    }
+}
+
+movement_step_history_t *_movement_step_counter_history(void) {
+    return &step_history;
+}
+
+uint32_t movement_get_step_count(void) {
+    return step_history.count;
+}
+
+uint8_t movement_get_steps_in_minute(uint8_t minutes_ago) {
+    // the bins belong to the FIFO callback, so rather than catching them up from here, work out where they'd be.
+    uint32_t elapsed = _movement_step_counter_current_minute() - step_history.bin_minute;
+
+    if (minutes_ago >= MOVEMENT_STEP_COUNTER_MINUTES || minutes_ago < elapsed) return 0;
+    minutes_ago -= elapsed;
+
+    return step_history.bins[(step_history.bin_head + MOVEMENT_STEP_COUNTER_MINUTES - minutes_ago) % MOVEMENT_STEP_COUNTER_MINUTES];
+}
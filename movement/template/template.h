@@ -43,6 +43,7 @@ void <#watch_face_name#>_face_resign(movement_settings_t *settings, void *contex
     <#watch_face_name#>_face_loop, \
     <#watch_face_name#>_face_resign, \
     NULL, \
+    sizeof(<#watch_face_name#>_state_t), \
 })
 
 #endif // <#WATCH_FACE_NAME#>_FACE_H_
@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "watch.h"
+#include "watch_utility.h"
+#include "movement.h"
+#include "lis2dw.h"
+
+// `make test` runs the step counter in movement_step_counter.c on synthetic accelerometer data. The LIS2DW and the
+// parts of Movement it calls are stubbed out below, so the test can hand it FIFO batches the way the driver would,
+// with a clock that moves 80 ms per sample, and watch what it turns on and off.
+
+#define STEP_COUNTER_TEST_HZ (12.5)
+// the FIFO threshold the step counter asks for; the stub checks it.
+#define STEP_COUNTER_TEST_BATCH (30)
+// 1 g, in the left justified 12-bit samples of low power mode 1.
+#define STEP_COUNTER_TEST_ONE_G (1000 << 4)
+
+static uint32_t test_failures;
+
+static lis2dw_fifo_t *test_fifo;
+static lis2dw_fifo_cb_t test_fifo_callback;
+static uint8_t test_accelerometer_claims;
+static int8_t test_le_interrupt_requests;
+static uint64_t test_sample;
+static uint32_t test_start_time;
+
+bool lis2dw_start_fifo_stream(uint8_t int1_pin, uint8_t threshold, lis2dw_fifo_t *buffer, lis2dw_fifo_cb_t callback) {
+    if (threshold != STEP_COUNTER_TEST_BATCH) {
+        printf("FAIL FIFO threshold is %d, expected %d\n", threshold, STEP_COUNTER_TEST_BATCH);
+        test_failures++;
+    }
+    test_fifo = buffer;
+    test_fifo_callback = callback;
+
+    return true;
+}
+
+void lis2dw_stop_fifo_stream(void) {
+    test_fifo_callback = NULL;
+}
+
+bool movement_claim_accelerometer(void) {
+    test_accelerometer_claims++;
+    return true;
+}
+
+void movement_release_accelerometer(void) {
+    test_accelerometer_claims--;
+}
+
+void movement_request_le_interrupts(bool enabled) {
+    test_le_interrupt_requests += enabled ? 1 : -1;
+}
+
+watch_date_time watch_rtc_get_date_time(void) {
+    return watch_utility_date_time_from_unix_time(test_start_time + test_sample / STEP_COUNTER_TEST_HZ, 0);
+}
+
+// xorshift32, for sensor noise that's the same on every run.
+static int16_t _step_counter_test_noise(int16_t amplitude) {
+    static uint32_t state = 2463534242UL;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return (int16_t)(state % (2 * amplitude + 1)) - amplitude;
+}
+
+// feeds seconds of samples through the FIFO callback, a batch at a time: gravity along one axis, plus a bounce along it
+// of amplitude mg at cadence steps per second (0 for standing still), plus ±24 mg of noise on every axis. returns the
+// steps counted. if the stream is paused, the samples go by without reaching the step counter, as they would on the
+// watch.
+static uint32_t _step_counter_test_feed(double seconds, double cadence, int16_t amplitude, uint8_t axis) {
+    uint32_t before = movement_get_step_count();
+    uint32_t samples = seconds * STEP_COUNTER_TEST_HZ;
+
+    while (samples) {
+        uint8_t count = (samples < STEP_COUNTER_TEST_BATCH) ? samples : STEP_COUNTER_TEST_BATCH;
+        for (uint8_t i = 0; i < count; i++) {
+            double t = test_sample++ / STEP_COUNTER_TEST_HZ;
+            int16_t values[3];
+            for (uint8_t j = 0; j < 3; j++) values[j] = _step_counter_test_noise(24 << 4);
+            values[axis] += STEP_COUNTER_TEST_ONE_G + (int16_t)(amplitude * 16 * sin(2 * M_PI * cadence * t));
+            if (test_fifo_callback) {
+                test_fifo->readings[i].x = values[0];
+                test_fifo->readings[i].y = values[1];
+                test_fifo->readings[i].z = values[2];
+            }
+        }
+        if (test_fifo_callback) {
+            test_fifo->count = count;
+            test_fifo_callback(test_fifo, false);
+        }
+        samples -= count;
+    }
+
+    return movement_get_step_count() - before;
+}
+
+static void _step_counter_test_expect(const char *name, uint32_t actual, uint32_t low, uint32_t high) {
+    if (actual >= low && actual <= high) {
+        printf("PASS %s: %u\n", name, actual);
+    } else {
+        printf("FAIL %s: %u, expected %u to %u\n", name, actual, low, high);
+        test_failures++;
+    }
+}
+
+int main(void) {
+    uint32_t steps;
+
+    // 2026-01-01 00:00:00, so that whole minutes line up with the samples.
+    test_start_time = 1767225600;
+
+    if (!movement_enable_step_counter() || test_fifo_callback == NULL || test_accelerometer_claims != 1 || test_le_interrupt_requests != 1) {
+        printf("FAIL enabling didn't claim the accelerometer, start the FIFO stream and request LE interrupts\n");
+        return 1;
+    }
+
+    _step_counter_test_expect("standing still for five minutes", _step_counter_test_feed(300, 0, 0, 2), 0, 0);
+    _step_counter_test_expect("swaying slowly for a minute", _step_counter_test_feed(60, 0.4, 60, 2), 0, 0);
+    // a minute at 1.8 steps a second is 108 steps; the detector can lose a step or two to noise at the edges.
+    _step_counter_test_expect("walking for a minute", _step_counter_test_feed(60, 1.8, 300, 2), 104, 108);
+    _step_counter_test_feed(10, 0, 0, 2);
+    _step_counter_test_expect("running for a minute", _step_counter_test_feed(60, 2.8, 800, 2), 162, 168);
+    _step_counter_test_feed(10, 0, 0, 2);
+    // the magnitude doesn't care which way the watch is facing.
+    _step_counter_test_expect("walking with the watch on its side", _step_counter_test_feed(60, 1.8, 300, 0), 104, 108);
+    _step_counter_test_feed(10, 0, 0, 2);
+    // a lone bump isn't a step: it takes a second one, within two seconds, to start a run.
+    _step_counter_test_expect("one bump", _step_counter_test_feed(0.56, 1.8, 300, 2) + _step_counter_test_feed(10, 0, 0, 2), 0, 0);
+    _step_counter_test_expect("two steps", _step_counter_test_feed(1.12, 1.8, 300, 2) + _step_counter_test_feed(10, 0, 0, 2), 2, 2);
+
+    // the minute bins: a walk from the top of a minute lands in that minute and the next, and stays there as time goes by.
+    _step_counter_test_feed(60 - fmod(test_sample / STEP_COUNTER_TEST_HZ, 60), 0, 0, 2);
+    steps = _step_counter_test_feed(90, 1.8, 300, 2);
+    _step_counter_test_expect("steps in this minute and the one before", movement_get_steps_in_minute(0) + movement_get_steps_in_minute(1), steps, steps);
+    _step_counter_test_feed(120, 0, 0, 2);
+    _step_counter_test_expect("steps in this minute, two minutes later", movement_get_steps_in_minute(0), 0, 0);
+    _step_counter_test_expect("steps two and three minutes ago", movement_get_steps_in_minute(2) + movement_get_steps_in_minute(3), steps, steps);
+
+    // tap detection pauses the stream; the steps taken meanwhile are lost, and counting picks up again afterwards.
+    _movement_step_counter_pause(true);
+    _step_counter_test_expect("walking while paused", _step_counter_test_feed(30, 1.8, 300, 2), 0, 0);
+    _movement_step_counter_pause(false);
+    _step_counter_test_expect("walking after the pause", _step_counter_test_feed(30, 1.8, 300, 2), 50, 54);
+
+    // enables are counted, so the accelerometer stays on until the last user goes away.
+    movement_enable_step_counter();
+    movement_disable_step_counter();
+    if (test_fifo_callback == NULL || test_accelerometer_claims != 1) {
+        printf("FAIL a second user's disable stopped the step counter\n");
+        test_failures++;
+    }
+    movement_disable_step_counter();
+    if (test_fifo_callback != NULL || test_accelerometer_claims != 0 || test_le_interrupt_requests != 0) {
+        printf("FAIL the last disable didn't stop the stream, release the accelerometer and drop the LE request\n");
+        test_failures++;
+    }
+
+    return test_failures ? 1 : 0;
+}
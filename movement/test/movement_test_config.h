@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_TEST_CONFIG_H_
+#define MOVEMENT_TEST_CONFIG_H_
+
+#include "movement_faces.h"
+
+// `make test` builds Movement with this in place of movement_config.h, so that every watch face gets run. Each script
+// in movement/test/faces runs on a watch of its own, which has just the face it's named for and the first face here
+// to come back to, so the order doesn't matter past keeping simple_clock_face first. A new face goes in anywhere,
+// one entry to a line, along with a script for it.
+const watch_face_t watch_faces[] = {
+    simple_clock_face,
+    world_clock_face,
+    preferences_face,
+    set_time_face,
+    pulsometer_face,
+    thermistor_readout_face,
+    thermistor_logging_face,
+    character_set_face,
+    beats_face,
+    day_one_face,
+    voltage_face,
+    stopwatch_face,
+    totp_face,
+    hello_there_face,
+    sunrise_sunset_face,
+    countdown_face,
+    blinky_face,
+    moon_phase_face,
+    orrery_face,
+    astronomy_face,
+    wake_profile_face,
+    activity_log_face,
+    level_face,
+    counter_face,
+    lis2dh_logging_face,
+    demo_face,
+};
+
+#define MOVEMENT_NUM_FACES (sizeof(watch_faces) / sizeof(watch_face_t))
+
+#endif // MOVEMENT_TEST_CONFIG_H_
@@ -0,0 +1,257 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_host.h"
+#include "spiflash.h"
+#include "watch_spi_flash_model.h"
+
+// `make test` runs the driver in spiflash.c against the flash model that the simulator and host builds put on the SPI
+// bus. The host glue is stubbed out below with a clock that only moves as bytes cross the bus, so the model's program
+// and erase times go by exactly as fast as the driver's waiting and polling make them. The model keeps its image in
+// the directory the test runs in, and the test deletes it when it's done.
+
+#define SPI_FLASH_TEST_INSTANCE (0)
+#define SPI_FLASH_TEST_FREQUENCY (1000000)
+// where the read tests start, on an odd address, and how much they have to play with.
+#define SPI_FLASH_TEST_READ_ADDRESS (0x50007)
+#define SPI_FLASH_TEST_READ_LENGTH (66000)
+// how far past the typical busy time an erase may run before we call its polling sloppy, in percent.
+#define SPI_FLASH_TEST_SLACK (5)
+
+static uint32_t test_failures;
+static uint64_t test_now;
+static uint8_t test_pattern[SPI_FLASH_TEST_READ_LENGTH];
+static uint8_t test_buffer[SPI_FLASH_TEST_READ_LENGTH + 1];
+
+uint64_t watch_host_get_time(void) {
+    return test_now;
+}
+
+uint32_t watch_host_get_instance(void) {
+    return SPI_FLASH_TEST_INSTANCE;
+}
+
+void _watch_host_delay(uint64_t duration) {
+    test_now += duration;
+}
+
+// xorshift32, so that every run writes the same bytes.
+static void _spi_flash_test_fill_pattern(void) {
+    uint32_t state = 2463534242UL;
+
+    for (uint32_t i = 0; i < sizeof(test_pattern); i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        test_pattern[i] = state;
+    }
+}
+
+static void _spi_flash_test_expect(const char *name, bool passed) {
+    printf("%s %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) test_failures++;
+}
+
+// asks for the JEDEC ID without waking the chip first; in deep power-down, it doesn't answer.
+static bool _spi_flash_test_is_awake(void) {
+    static const uint8_t expected[] = SPI_FLASH_MODEL_JEDEC_ID;
+    uint8_t command = CMD_READ_JEDEC_ID;
+    uint8_t id[sizeof(expected)];
+
+    watch_set_pin_level(A3, false);
+    watch_spi_write(&command, 1);
+    watch_spi_read(id, sizeof(id));
+    watch_set_pin_level(A3, true);
+
+    return memcmp(id, expected, sizeof(id)) == 0;
+}
+
+static bool _spi_flash_test_is_busy(void) {
+    uint8_t status = SPI_FLASH_STATUS_WIP;
+
+    spi_flash_read_command(CMD_READ_STATUS, &status, 1);
+
+    return status & SPI_FLASH_STATUS_WIP;
+}
+
+static bool _spi_flash_test_bytes_are(uint32_t address, uint32_t length, uint8_t value) {
+    if (!spi_flash_read_data(address, test_buffer, length)) return false;
+    for (uint32_t i = 0; i < length; i++) if (test_buffer[i] != value) return false;
+
+    return true;
+}
+
+static void _spi_flash_test_power_down(void) {
+    bool passed;
+
+    _spi_flash_test_expect("asleep after spi_flash_init", !_spi_flash_test_is_awake());
+    spi_flash_wake();
+    _spi_flash_test_expect("awake after spi_flash_wake", _spi_flash_test_is_awake());
+    spi_flash_wake();
+    spi_flash_sleep();
+    _spi_flash_test_expect("still awake after a nested wake and sleep", _spi_flash_test_is_awake());
+    passed = spi_flash_read_data(0, test_buffer, 16) && _spi_flash_test_is_awake();
+    _spi_flash_test_expect("still awake after a read inside the wake", passed);
+    spi_flash_sleep();
+    _spi_flash_test_expect("asleep after the last spi_flash_sleep", !_spi_flash_test_is_awake());
+    // one sleep too many mustn't leave the count behind, so that the next wake still wakes it.
+    spi_flash_sleep();
+    spi_flash_wake();
+    passed = _spi_flash_test_is_awake();
+    spi_flash_sleep();
+    _spi_flash_test_expect("an extra spi_flash_sleep is ignored", passed && !_spi_flash_test_is_awake());
+}
+
+static void _spi_flash_test_write(void) {
+    uint64_t start = test_now;
+    bool passed;
+
+    // 16 bytes to the end of one page, two whole pages, and 172 bytes into a fourth: four page programs.
+    passed = spi_flash_write_data(0x1F0, test_pattern, 700);
+    _spi_flash_test_expect("a write across four pages doesn't return while the chip is busy", passed && !_spi_flash_test_is_busy() && test_now - start >= 4 * SPI_FLASH_MODEL_PAGE_PROGRAM_TIME * 1000000);
+    passed = _spi_flash_test_bytes_are(0x100, 0xF0, 0xFF) &&
+             spi_flash_read_data(0x1F0, test_buffer, 700) && memcmp(test_buffer, test_pattern, 700) == 0 &&
+             _spi_flash_test_bytes_are(0x1F0 + 700, 0x600 - (0x1F0 + 700), 0xFF);
+    _spi_flash_test_expect("a write across four pages lands where it should", passed);
+
+    passed = spi_flash_write_data(0x6FF, test_pattern, 1) && spi_flash_write_data(0x700, test_pattern + 1, 256) &&
+             spi_flash_read_data(0x6FF, test_buffer, 257) && memcmp(test_buffer, test_pattern, 257) == 0 &&
+             _spi_flash_test_bytes_are(0x800, 0x100, 0xFF);
+    _spi_flash_test_expect("writes of the last byte of a page and of a whole page", passed);
+}
+
+// erases length bytes at address, and checks that it took as long as the blocks it should have picked.
+static void _spi_flash_test_erase(const char *name, uint32_t address, uint32_t length, double typical_ms) {
+    uint64_t start = test_now;
+    bool passed = spi_flash_erase(address, length) && !_spi_flash_test_is_busy();
+    double elapsed_ms = (test_now - start) / 1000000.0;
+
+    if (passed && elapsed_ms >= typical_ms && elapsed_ms <= typical_ms * (100 + SPI_FLASH_TEST_SLACK) / 100) {
+        printf("PASS %s: %.1f ms\n", name, elapsed_ms);
+    } else {
+        printf("FAIL %s: %.1f ms, expected %.0f\n", name, elapsed_ms, typical_ms);
+        test_failures++;
+    }
+}
+
+static void _spi_flash_test_erase_blocks(void) {
+    uint8_t marker = 0;
+    bool passed = true;
+
+    // mark the first byte of every sector in the first 256K, then erase some of them.
+    for (uint32_t address = 0; address <= 0x40000; address += SPI_FLASH_SECTOR_SIZE) {
+        passed &= spi_flash_write_data(address, &marker, 1);
+    }
+    _spi_flash_test_expect("marking every sector", passed);
+
+    _spi_flash_test_expect("an unaligned erase is refused", !spi_flash_erase(0x1800, SPI_FLASH_SECTOR_SIZE));
+    _spi_flash_test_erase("8K from a sector: two sectors", 0x2000, 0x2000, 2 * SPI_FLASH_MODEL_SECTOR_ERASE_TIME);
+    _spi_flash_test_erase("36K from a 32K block: a 32K block and a sector", 0x8000, 0x9000, SPI_FLASH_MODEL_BLOCK_32K_ERASE_TIME + SPI_FLASH_MODEL_SECTOR_ERASE_TIME);
+    _spi_flash_test_erase("128K from a 64K block: two 64K blocks", 0x20000, 0x20000, 2 * SPI_FLASH_MODEL_BLOCK_64K_ERASE_TIME);
+
+    for (uint32_t address = 0; address <= 0x40000; address += SPI_FLASH_SECTOR_SIZE) {
+        bool erased = (address >= 0x2000 && address < 0x4000) || (address >= 0x8000 && address < 0x11000) || (address >= 0x20000 && address < 0x40000);
+        if (!spi_flash_read_data(address, test_buffer, 1) || test_buffer[0] != (erased ? 0xFF : marker)) {
+            printf("FAIL the sector at 0x%05x was %s\n", address, erased ? "left alone" : "erased");
+            test_failures++;
+            return;
+        }
+    }
+    _spi_flash_test_expect("erases touch the sectors they should and no others", true);
+}
+
+static void _spi_flash_test_store_status(int32_t status, void *context) {
+    *(int32_t *)context = status;
+}
+
+// the callback comes from interrupt context, which mustn't block, so the chip stays up at the bulk clock until the next
+// call into the driver puts things back.
+static void _spi_flash_test_read_async(void) {
+    int32_t status = -1;
+    bool passed;
+
+    passed = spi_flash_read_data_async(SPI_FLASH_TEST_READ_ADDRESS, test_buffer, 4096, _spi_flash_test_store_status, &status) &&
+             status == 0 && memcmp(test_buffer, test_pattern, 4096) == 0;
+    _spi_flash_test_expect("an async read calls back with the data", passed);
+    _spi_flash_test_expect("the callback leaves the chip awake at the bulk clock", _spi_flash_test_is_awake() && watch_spi_get_frequency() == SPI_FLASH_BULK_FREQUENCY);
+    spi_flash_wait();
+    _spi_flash_test_expect("spi_flash_wait puts the chip to sleep and the clock back", !_spi_flash_test_is_awake() && watch_spi_get_frequency() == SPI_FLASH_TEST_FREQUENCY);
+
+    // a wake after the read takes over its hold on the chip, and the matching sleep lets go of it.
+    spi_flash_read_data_async(SPI_FLASH_TEST_READ_ADDRESS, test_buffer, 4096, NULL, NULL);
+    spi_flash_wake();
+    passed = _spi_flash_test_is_awake() && watch_spi_get_frequency() == SPI_FLASH_TEST_FREQUENCY;
+    spi_flash_sleep();
+    _spi_flash_test_expect("a wake after an async read finishes it", passed && !_spi_flash_test_is_awake());
+}
+
+static void _spi_flash_test_read(bool fast_read) {
+    static const uint32_t lengths[] = {1, 2, 3, 63, 64, 255, 256, 257, 4096, 32767, 32768, 32769, 65535, 65536, 65537, SPI_FLASH_TEST_READ_LENGTH};
+    char name[64];
+
+    spi_flash_set_fast_read(fast_read);
+    for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        uint32_t length = lengths[i];
+        memset(test_buffer, 0xA5, sizeof(test_buffer));
+        bool passed = spi_flash_read_data(SPI_FLASH_TEST_READ_ADDRESS, test_buffer, length) &&
+                      memcmp(test_buffer, test_pattern, length) == 0 && test_buffer[length] == 0xA5 &&
+                      watch_spi_get_frequency() == SPI_FLASH_TEST_FREQUENCY && !_spi_flash_test_is_awake();
+        if (!passed) {
+            printf("FAIL %s of %u bytes\n", fast_read ? "FAST_READ" : "READ", length);
+            test_failures++;
+            return;
+        }
+    }
+    snprintf(name, sizeof(name), "%s of 1 to %u bytes", fast_read ? "FAST_READ" : "READ", SPI_FLASH_TEST_READ_LENGTH);
+    _spi_flash_test_expect(name, true);
+}
+
+int main(void) {
+    char path[64];
+
+    snprintf(path, sizeof(path), SPI_FLASH_MODEL_HOST_PATH, SPI_FLASH_TEST_INSTANCE);
+    remove(path);
+    _spi_flash_test_fill_pattern();
+
+    spi_flash_init();
+    watch_spi_set_frequency(SPI_FLASH_TEST_FREQUENCY);
+
+    _spi_flash_test_power_down();
+    _spi_flash_test_write();
+    _spi_flash_test_erase_blocks();
+
+    _spi_flash_test_expect("writing the read pattern", spi_flash_write_data(SPI_FLASH_TEST_READ_ADDRESS, test_pattern, sizeof(test_pattern)));
+    _spi_flash_test_read(false);
+    _spi_flash_test_read(true);
+    _spi_flash_test_read_async();
+
+    spi_flash_model_close();
+    remove(path);
+
+    return test_failures ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "watch_utility.h"
+
+// `make test` checks the integer math in watch_utility.c against libm on the host. isqrt gets every value below 2^24
+// and both sides of every perfect square, which is every place its answer changes; -a sweeps all 2^32 inputs instead,
+// which takes a couple of minutes. atan2 and magnitude get every vector the accelerometer's 12-bit readings can make,
+// the corners of the int32 range, and a few million pseudorandom vectors at every scale in between.
+
+// how many failures of each function to print before we just count them.
+#define WATCH_UTILITY_TEST_MAX_REPORTS (10)
+
+static uint32_t failures;
+static uint32_t reports;
+
+static void _watch_utility_test_fail(const char *format, ...) {
+    va_list args;
+
+    failures++;
+    if (reports++ >= WATCH_UTILITY_TEST_MAX_REPORTS) return;
+    va_start(args, format);
+    printf("FAIL ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+}
+
+// xorshift32, so that every run checks the same vectors.
+static uint32_t _watch_utility_test_random(void) {
+    static uint32_t state = 2463534242UL;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+static void _watch_utility_test_isqrt_value(uint32_t value) {
+    uint16_t expected = floor(sqrt((double)value));
+    uint16_t actual = watch_utility_isqrt(value);
+
+    if (actual != expected) _watch_utility_test_fail("isqrt(%u) = %u, expected %u", value, actual, expected);
+}
+
+static void _watch_utility_test_isqrt(bool all) {
+    if (all) {
+        uint32_t value = 0;
+        do {
+            _watch_utility_test_isqrt_value(value);
+        } while (++value);
+        return;
+    }
+
+    for (uint32_t value = 0; value < (1UL << 24); value++) _watch_utility_test_isqrt_value(value);
+    for (uint32_t root = 1; root <= UINT16_MAX; root++) {
+        _watch_utility_test_isqrt_value(root * root - 1);
+        _watch_utility_test_isqrt_value(root * root);
+    }
+    _watch_utility_test_isqrt_value(UINT32_MAX);
+}
+
+// the header promises 0.01 degrees, so the answer can be a hundredth either side of libm's before rounding.
+static void _watch_utility_test_atan2_vector(int32_t y, int32_t x) {
+    double expected = (x == 0 && y == 0) ? 0 : atan2(y, x) * 18000 / M_PI;
+    int16_t actual = watch_utility_atan2(y, x);
+    double error = fabs(actual - expected);
+
+    // -18000 and 18000 are the same direction.
+    if (error > 18000) error = 36000 - error;
+    if (error > 1) _watch_utility_test_fail("atan2(%d, %d) = %d, expected %.2f", y, x, actual, expected);
+}
+
+// the answer is rounded, so it can be half off; past a few million, the bits the CORDIC steps shift out of x and y add
+// up to as much as one part in 2^25 more.
+static void _watch_utility_test_magnitude_vector(int32_t x, int32_t y) {
+    double expected = hypot(x, y);
+    uint32_t actual = watch_utility_magnitude(x, y);
+
+    if (fabs(actual - expected) > 0.5 + expected / (1UL << 25)) {
+        _watch_utility_test_fail("magnitude(%d, %d) = %u, expected %.2f", x, y, actual, expected);
+    }
+}
+
+static void _watch_utility_test_vector(int32_t x, int32_t y) {
+    _watch_utility_test_atan2_vector(y, x);
+    _watch_utility_test_magnitude_vector(x, y);
+}
+
+static void _watch_utility_test_vectors(void) {
+    const int32_t corners[] = {INT32_MIN, INT32_MIN + 1, -1, 0, 1, INT32_MAX - 1, INT32_MAX};
+    const uint8_t num_corners = sizeof(corners) / sizeof(corners[0]);
+
+    for (int32_t x = -2048; x < 2048; x++) {
+        for (int32_t y = -2048; y < 2048; y++) _watch_utility_test_vector(x, y);
+    }
+    for (uint8_t i = 0; i < num_corners; i++) {
+        for (uint8_t j = 0; j < num_corners; j++) _watch_utility_test_vector(corners[i], corners[j]);
+    }
+    // shifting each component by its own random amount mixes small vectors, huge ones and lopsided ones.
+    for (uint32_t i = 0; i < 4000000; i++) {
+        int32_t x = (int32_t)_watch_utility_test_random() >> (_watch_utility_test_random() % 32);
+        int32_t y = (int32_t)_watch_utility_test_random() >> (_watch_utility_test_random() % 32);
+        _watch_utility_test_vector(x, y);
+    }
+}
+
+static bool _watch_utility_test_report(const char *name) {
+    bool passed = (failures == 0);
+
+    if (passed) printf("PASS %s\n", name);
+    else printf("FAIL %s: %u failures\n", name, failures);
+    failures = 0;
+    reports = 0;
+
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    bool all = (argc > 1 && strcmp(argv[1], "-a") == 0);
+    bool passed = true;
+
+    _watch_utility_test_isqrt(all);
+    passed &= _watch_utility_test_report("watch_utility_isqrt");
+    _watch_utility_test_vectors();
+    passed &= _watch_utility_test_report("watch_utility_atan2 and watch_utility_magnitude");
+
+    return passed ? 0 : 1;
+}
@@ -20,6 +20,7 @@ void beats_face_resign(movement_settings_t *settings, void *context);
     beats_face_loop, \
     beats_face_resign, \
     NULL, \
+    sizeof(beats_face_state_t), \
 })
 
 #endif // BEATS_FACE_H_
\ No newline at end of file
@@ -29,10 +29,8 @@
 
 typedef struct {
     uint32_t previous_date_time;
-    uint8_t last_battery_check;
     uint8_t watch_face_index;
     bool signal_enabled;
-    bool battery_low;
 } simple_clock_state_t;
 
 void simple_clock_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -47,6 +45,7 @@ bool simple_clock_face_wants_background_task(movement_settings_t *settings, void
     simple_clock_face_loop, \
     simple_clock_face_resign, \
     simple_clock_face_wants_background_task, \
+    sizeof(simple_clock_state_t), \
 })
 
 #endif // SIMPLE_CLOCK_FACE_H_
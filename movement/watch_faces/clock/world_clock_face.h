@@ -55,6 +55,7 @@ uint8_t world_clock_face_get_weekday(uint16_t day, uint16_t month, uint16_t year
     world_clock_face_loop, \
     world_clock_face_resign, \
     NULL, \
+    sizeof(world_clock_state_t), \
 })
 
 #endif // WORLD_CLOCK_FACE_H_
@@ -84,6 +84,8 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
     date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
     double jd = astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
 
+    // the ephemeris math takes seconds in soft float at 4 MHz; run it at 16 MHz and get back to sleep sooner.
+    watch_request_performance(WATCH_PERFORMANCE_HIGH);
     astro_equatorial_coordinates_t radec_precession = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, true);
     printf("\nParams to convert: %f %f %f %f %f\n",
             jd,
@@ -114,6 +116,7 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
             state->altitude,
             state->azimuth,
             state->distance);
+    watch_request_performance(WATCH_PERFORMANCE_NORMAL);
 }
 
 static void _astronomy_face_update(movement_event_t event, movement_settings_t *settings, astronomy_state_t *state) {
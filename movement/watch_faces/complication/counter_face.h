@@ -46,6 +46,7 @@ void print_counter(counter_state_t *state);
     counter_face_loop, \
     counter_face_resign, \
     NULL, \
+    sizeof(counter_state_t), \
 })
 
 #endif // COUNTER_FACE_H_
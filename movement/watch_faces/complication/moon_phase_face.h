@@ -42,6 +42,7 @@ void moon_phase_face_resign(movement_settings_t *settings, void *context);
     moon_phase_face_loop, \
     moon_phase_face_resign, \
     NULL, \
+    sizeof(moon_phase_state_t), \
 })
 
 #endif // MOON_PHASE_FACE_H_
@@ -55,6 +55,8 @@ static void _orrery_face_recalculate(movement_settings_t *settings, orrery_state
     double et = astro_convert_jd_to_julian_millenia_since_j2000(jd);
     double r[3] = {0};
 
+    // VSOP87 in soft float takes seconds at 4 MHz; run it at 16 MHz and get back to sleep sooner.
+    watch_request_performance(WATCH_PERFORMANCE_HIGH);
     switch(state->active_body_index) {
         case 0:
             vsop87a_milli_getMercury(et, r);
@@ -90,6 +92,7 @@ static void _orrery_face_recalculate(movement_settings_t *settings, orrery_state
             vsop87a_milli_getNeptune(et, r);
             break;
     }
+    watch_request_performance(WATCH_PERFORMANCE_NORMAL);
     state->coords[0] = r[0];
     state->coords[1] = r[1];
     state->coords[2] = r[2];
@@ -45,6 +45,7 @@ void stopwatch_face_resign(movement_settings_t *settings, void *context);
     stopwatch_face_loop, \
     stopwatch_face_resign, \
     NULL, \
+    sizeof(stopwatch_state_t), \
 })
 
 #endif // STOPWATCH_FACE_H_
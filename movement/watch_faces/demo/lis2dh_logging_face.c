@@ -29,13 +29,32 @@
 #include "watch.h"
 
 // This watch face is just for testing; if we want to build accelerometer support, it will likely have to be part of Movement itself.
-// The watch face only logs events when it is on screen and not in low energy mode, so you should set LE mode to Never when using it
-// and make it the first watch face in the list (so we come back to it from other modes).
+// The watch face only logs events when it is on screen, so you should make it the first watch face in the list (so we come back to
+// it from other modes). Events are counted from the INT1 interrupt, so it keeps logging in low energy mode.
 // On an interrupt, it flashes the Signal icon, and displays the axis or axes that were over the threshold.
 // The main display contains, from left to right, the number of interrupt events that were detected in each of the last three minutes.
 // Pressing the alarm button enters the log mode, where the main display shows the number of interrupts detected in each of the last
 // 24 hours (the hour is shown in the top right digit and AM/PM indicator, if the clock is set to 12 hour mode)
 
+static WATCH_INSTANCE_LOCAL lis2dh_logger_state_t *_lis2dh_logger_state;
+
+static void _lis2dh_logging_face_int1_state_read(lis2dh_interrupt_state interrupt_state) {
+    lis2dh_logger_state_t *logger_state = _lis2dh_logger_state;
+    if (logger_state == NULL) return;
+
+    logger_state->interrupt_state |= interrupt_state;
+    logger_state->interrupts[0]++;
+    if (interrupt_state & LIS2DH_INTERRUPT_STATE_X_HIGH) logger_state->x_interrupts_this_hour++;
+    if (interrupt_state & LIS2DH_INTERRUPT_STATE_Y_HIGH) logger_state->y_interrupts_this_hour++;
+    if (interrupt_state & LIS2DH_INTERRUPT_STATE_Z_HIGH) logger_state->z_interrupts_this_hour++;
+}
+
+static void _lis2dh_logging_face_int1_interrupt(void) {
+    // count the event right here instead of waiting for a tick, which in low energy mode is a minute away.
+    // INT1 is latched, so it stays high (and we won't see another edge) until this read of INT1_SRC completes.
+    lis2dh_get_int1_state_async(_lis2dh_logging_face_int1_state_read);
+}
+
 static void _lis2dh_logging_face_update_display(movement_settings_t *settings, lis2dh_logger_state_t *logger_state, lis2dh_interrupt_state interrupt_state) {
     char buf[14];
     char time_indication_character;
@@ -133,14 +152,22 @@ void lis2dh_logging_face_setup(movement_settings_t *settings, uint8_t watch_face
 
 void lis2dh_logging_face_activate(movement_settings_t *settings, void *context) {
     lis2dh_logger_state_t *logger_state = (lis2dh_logger_state_t *)context;
-    // force two settings: never enter low energy mode, and always snap back to screen 0.
+    // force one setting: always snap back to screen 0.
     // this assumes the accelerometer face is first in the watch_faces list.
-    settings->bit.le_interval = 0;
     settings->bit.to_always = true;
 
     logger_state->display_index = 0;
     logger_state->log_ticks = 0;
-    watch_enable_digital_input(A1);
+    _lis2dh_logger_state = logger_state;
+    // coming back from low energy mode, the interrupt is still registered and our request still stands.
+    if (!logger_state->le_interrupts_requested) {
+        watch_register_interrupt_callback(A1, _lis2dh_logging_face_int1_interrupt, INTERRUPT_TRIGGER_RISING);
+        // keep the interrupt and the bus running in low energy mode, so that we go on counting there.
+        movement_request_le_interrupts(true);
+        logger_state->le_interrupts_requested = true;
+    }
+    // an event that came in while we were away has left INT1 latched high, and it won't give us an edge until it's read.
+    if (watch_get_pin_level(A1)) _lis2dh_logging_face_int1_interrupt();
 }
 
 bool lis2dh_logging_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -172,13 +199,11 @@ bool lis2dh_logging_face_loop(movement_event_t event, movement_settings_t *setti
             } else {
                 logger_state->display_index = 0;
             }
-            if (watch_get_pin_level(A1)) {
+            // the interrupt has already counted anything that happened since the last tick; we just show it.
+            interrupt_state = logger_state->interrupt_state;
+            logger_state->interrupt_state = 0;
+            if (interrupt_state) {
                 watch_set_indicator(WATCH_INDICATOR_SIGNAL);
-                interrupt_state = lis2dh_get_int1_state();
-                logger_state->interrupts[0]++;
-                if (interrupt_state & LIS2DH_INTERRUPT_STATE_X_HIGH) logger_state->x_interrupts_this_hour++;
-                if (interrupt_state & LIS2DH_INTERRUPT_STATE_Y_HIGH) logger_state->y_interrupts_this_hour++;
-                if (interrupt_state & LIS2DH_INTERRUPT_STATE_Z_HIGH) logger_state->z_interrupts_this_hour++;
             } else {
                 watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
             }
@@ -196,8 +221,12 @@ bool lis2dh_logging_face_loop(movement_event_t event, movement_settings_t *setti
 
 void lis2dh_logging_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
-    (void) context;
+    lis2dh_logger_state_t *logger_state = (lis2dh_logger_state_t *)context;
+    movement_request_le_interrupts(false);
+    logger_state->le_interrupts_requested = false;
+    watch_register_interrupt_callback(A1, NULL, INTERRUPT_TRIGGER_NONE);
     watch_disable_digital_input(A1);
+    _lis2dh_logger_state = NULL;
 }
 
 bool lis2dh_logging_face_wants_background_task(movement_settings_t *settings, void *context) {
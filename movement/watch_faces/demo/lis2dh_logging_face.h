@@ -43,9 +43,11 @@ typedef struct {
     uint8_t log_ticks;      // when the user taps the ALARM button, we enter log mode
     int32_t data_points;    // the absolute number of data points logged
     uint8_t interrupts[3];  // the number of interrupts we have logged in each of the last 3 minutes
+    uint8_t interrupt_state;    // the axes that went over the threshold since the last tick
     uint32_t x_interrupts_this_hour;  // the number of interrupts we have logged in the last hour
     uint32_t y_interrupts_this_hour;  // the number of interrupts we have logged in the last hour
     uint32_t z_interrupts_this_hour;  // the number of interrupts we have logged in the last hour
+    bool le_interrupts_requested;     // activate runs again on the way out of low energy mode, without a resign
     lis2dh_logger_data_point_t data[LIS2DH_LOGGING_NUM_DATA_POINTS];
 } lis2dh_logger_state_t;
 
@@ -61,6 +63,7 @@ bool lis2dh_logging_face_wants_background_task(movement_settings_t *settings, vo
     lis2dh_logging_face_loop, \
     lis2dh_logging_face_resign, \
     lis2dh_logging_face_wants_background_task, \
+    sizeof(lis2dh_logger_state_t), \
 })
 
 #endif // LIS2DH_LOGGING_FACE_H_
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "wake_profile_face.h"
+#include "watch.h"
+
+static void _wake_profile_face_update_display(wake_profile_state_t *state) {
+    char buf[14];
+    const watch_profile_histogram_t *histogram = watch_profile_get_face_histogram(state->face_index);
+
+    if (histogram == NULL) {
+        sprintf(buf, "WP     OFF");
+    } else if (histogram->count == 0) {
+        sprintf(buf, "WP%2d  ----", state->face_index);
+    } else {
+        uint32_t mean = (histogram->total_ticks / histogram->count) * WATCH_PROFILE_TICK_US;
+        sprintf(buf, "WP%2d%6lu", state->face_index, mean > 999999 ? 999999 : mean);
+    }
+    watch_display_string(buf, 0);
+}
+
+void wake_profile_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        *context_ptr = malloc(sizeof(wake_profile_state_t));
+        memset(*context_ptr, 0, sizeof(wake_profile_state_t));
+    }
+}
+
+void wake_profile_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+}
+
+bool wake_profile_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    (void) settings;
+    wake_profile_state_t *state = (wake_profile_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_MODE_BUTTON_UP:
+            movement_move_to_next_face();
+            break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            movement_illuminate_led();
+            break;
+        case EVENT_ALARM_BUTTON_UP:
+            state->face_index = (state->face_index + 1) % WATCH_PROFILE_NUM_FACES;
+            _wake_profile_face_update_display(state);
+            break;
+        case EVENT_ALARM_LONG_PRESS:
+            watch_profile_print();
+            break;
+        case EVENT_ACTIVATE:
+        case EVENT_TICK:
+            _wake_profile_face_update_display(state);
+            break;
+        case EVENT_LOW_ENERGY_UPDATE:
+            watch_display_string("WP  SLEEP ", 0);
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+void wake_profile_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+}
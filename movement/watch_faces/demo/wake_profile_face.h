@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef WAKE_PROFILE_FACE_H_
+#define WAKE_PROFILE_FACE_H_
+
+#include "movement.h"
+
+/*
+ * WAKE PROFILE
+ *
+ * A debug face for firmware built with `make PROFILE=1`. Shows the mean time (in microseconds) that
+ * the watch stays awake each time it wakes to service a given watch face, so you can see which faces
+ * blow the active time budget. The day digits show the face index; press ALARM to step through them.
+ * A long press on ALARM prints the full set of histograms, per event type and per face, to the USB
+ * serial console.
+ */
+
+typedef struct {
+    uint8_t face_index;
+} wake_profile_state_t;
+
+void wake_profile_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void wake_profile_face_activate(movement_settings_t *settings, void *context);
+bool wake_profile_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void wake_profile_face_resign(movement_settings_t *settings, void *context);
+
+#define wake_profile_face ((const watch_face_t){ \
+    wake_profile_face_setup, \
+    wake_profile_face_activate, \
+    wake_profile_face_loop, \
+    wake_profile_face_resign, \
+    NULL, \
+    sizeof(wake_profile_state_t), \
+})
+
+#endif // WAKE_PROFILE_FACE_H_
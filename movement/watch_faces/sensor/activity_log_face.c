@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "activity_log_face.h"
+#include "watch.h"
+
+#define ACTIVITY_LOG_FACE_EPOCHS_PER_DAY (24 * 60 / MOVEMENT_ACTIVITY_EPOCH_MINUTES)
+#define ACTIVITY_LOG_FACE_NUM_PAGES (3)
+
+// the log may not go back as far as we'd like to look yet.
+static uint16_t _activity_log_face_epochs_available(uint16_t wanted) {
+    uint16_t logged = movement_get_activity_epochs_logged();
+
+    return (logged < wanted) ? logged : wanted;
+}
+
+static uint16_t _activity_log_face_active_minutes(uint32_t now, uint16_t epochs) {
+    uint16_t minutes = 0;
+
+    for (uint16_t i = 0; i < epochs; i++) minutes += movement_get_activity(now, i);
+
+    return minutes;
+}
+
+static uint16_t _activity_log_face_average_active_minutes(uint32_t now) {
+    uint16_t epochs = _activity_log_face_epochs_available(7 * ACTIVITY_LOG_FACE_EPOCHS_PER_DAY);
+    uint16_t days = (epochs + ACTIVITY_LOG_FACE_EPOCHS_PER_DAY - 1) / ACTIVITY_LOG_FACE_EPOCHS_PER_DAY;
+
+    if (!days) return 0;
+
+    return _activity_log_face_active_minutes(now, epochs) / days;
+}
+
+static uint16_t _activity_log_face_longest_still_minutes(uint32_t now) {
+    uint16_t epochs = _activity_log_face_epochs_available(ACTIVITY_LOG_FACE_EPOCHS_PER_DAY);
+    uint16_t run = 0, longest = 0;
+
+    for (uint16_t i = 0; i < epochs; i++) {
+        if (movement_get_activity(now, i)) {
+            run = 0;
+        } else if (++run > longest) {
+            longest = run;
+        }
+    }
+
+    return longest * MOVEMENT_ACTIVITY_EPOCH_MINUTES;
+}
+
+static void _activity_log_face_update_display(activity_log_state_t *state) {
+    char buf[14];
+    uint16_t minutes;
+    uint32_t now;
+
+    if (!state->logging) {
+        watch_clear_colon();
+        watch_display_string("AC    none", 0);
+        return;
+    }
+
+    // a page looks at hundreds of epochs; they're all counted back from the same one.
+    now = movement_get_activity_epoch();
+    switch (state->page) {
+        case 0:
+            minutes = _activity_log_face_active_minutes(now, _activity_log_face_epochs_available(ACTIVITY_LOG_FACE_EPOCHS_PER_DAY));
+            sprintf(buf, "AC24%2d%02d  ", minutes / 60, minutes % 60);
+            break;
+        case 1:
+            minutes = _activity_log_face_average_active_minutes(now);
+            sprintf(buf, "AV 7%2d%02d  ", minutes / 60, minutes % 60);
+            break;
+        default:
+            minutes = _activity_log_face_longest_still_minutes(now);
+            sprintf(buf, "ST24%2d%02d  ", minutes / 60, minutes % 60);
+            break;
+    }
+    watch_set_colon();
+    watch_display_string(buf, 0);
+}
+
+void activity_log_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        activity_log_state_t *state = malloc(sizeof(activity_log_state_t));
+        memset(state, 0, sizeof(activity_log_state_t));
+        // the log runs from boot whether or not we're on screen; setup is the one place that's called exactly once.
+        state->logging = movement_enable_activity_log();
+        *context_ptr = state;
+    }
+}
+
+void activity_log_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    activity_log_state_t *state = (activity_log_state_t *)context;
+    state->page = 0;
+}
+
+bool activity_log_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    (void) settings;
+    activity_log_state_t *state = (activity_log_state_t *)context;
+    switch (event.event_type) {
+        case EVENT_TIMEOUT:
+            movement_move_to_face(0);
+            break;
+        case EVENT_MODE_BUTTON_UP:
+            movement_move_to_next_face();
+            break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            movement_illuminate_led();
+            break;
+        case EVENT_ALARM_BUTTON_DOWN:
+            state->page = (state->page + 1) % ACTIVITY_LOG_FACE_NUM_PAGES;
+            // fall through
+        case EVENT_ACTIVATE:
+        case EVENT_LOW_ENERGY_UPDATE:
+            _activity_log_face_update_display(state);
+            break;
+        case EVENT_TICK:
+            // the log only changes minute by minute.
+            if (watch_rtc_get_date_time().unit.second == 0) _activity_log_face_update_display(state);
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+void activity_log_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+}
@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef ACTIVITY_LOG_FACE_H_
+#define ACTIVITY_LOG_FACE_H_
+
+#include "movement.h"
+
+/*
+ * ACTIVITY LOG
+ *
+ * Starts Movement's activity log when the watch boots and keeps it running in the background, then
+ * sums it up. ALARM steps through three pages, each shown as hours and minutes:
+ *   AC 24: active time in the last 24 hours.
+ *   AV  7: average active time per day over the last week, or however much of it has been logged.
+ *   ST 24: the longest stretch without any activity in the last 24 hours, which is usually sleep.
+ * Shows "none" if there's no accelerometer to log with.
+ */
+
+typedef struct {
+    uint8_t page;
+    bool logging;
+} activity_log_state_t;
+
+void activity_log_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void activity_log_face_activate(movement_settings_t *settings, void *context);
+bool activity_log_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void activity_log_face_resign(movement_settings_t *settings, void *context);
+
+#define activity_log_face ((const watch_face_t){ \
+    activity_log_face_setup, \
+    activity_log_face_activate, \
+    activity_log_face_loop, \
+    activity_log_face_resign, \
+    NULL, \
+    sizeof(activity_log_state_t), \
+})
+
+#endif // ACTIVITY_LOG_FACE_H_
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "level_face.h"
+#include "lis2dw.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+#define LEVEL_FACE_NUM_PAGES (3)
+// past this much tilt away from flat, in hundredths of a degree, the watch is on its edge enough to have a "down".
+#define LEVEL_FACE_MIN_ORIENTATION_TILT (2000)
+
+// whole degrees, rounded, from the hundredths that the CORDIC routines return.
+static int16_t _level_face_degrees(int32_t centidegrees) {
+    return (centidegrees + (centidegrees < 0 ? -50 : 50)) / 100;
+}
+
+static void _level_face_update_display(level_state_t *state) {
+    lis2dw_reading_t reading;
+    char buf[14];
+    int16_t tilt, angle;
+
+    if (!state->has_accelerometer) {
+        watch_display_string("LV    none", 0);
+        return;
+    }
+
+    // the readings' scale doesn't matter to an angle, so there's no need to convert them to g first.
+    reading = lis2dw_get_raw_reading();
+    switch (state->page) {
+        case 0:
+            sprintf(buf, "LV  %3d%3d",
+                    _level_face_degrees(watch_utility_atan2(-reading.x, watch_utility_magnitude(reading.y, reading.z))),
+                    _level_face_degrees(watch_utility_atan2(reading.y, reading.z)));
+            break;
+        case 1:
+            tilt = watch_utility_atan2(watch_utility_magnitude(reading.x, reading.y), reading.z);
+            sprintf(buf, "TL  %4d# ", _level_face_degrees(tilt));
+            break;
+        default:
+            tilt = watch_utility_atan2(watch_utility_magnitude(reading.x, reading.y), reading.z);
+            if (tilt < LEVEL_FACE_MIN_ORIENTATION_TILT) {
+                sprintf(buf, "OR    --  ");
+                break;
+            }
+            // the sensor reads the push back against gravity, so down is the other way. +Y is toward 12 o'clock and +X
+            // toward 3 o'clock, so atan2 with its arguments swapped measures clockwise from 12.
+            angle = _level_face_degrees(watch_utility_atan2(-reading.x, -reading.y));
+            if (angle < 0) angle += 360;
+            sprintf(buf, "OR  %4d# ", angle);
+            break;
+    }
+    watch_display_string(buf, 0);
+}
+
+void level_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        *context_ptr = malloc(sizeof(level_state_t));
+        memset(*context_ptr, 0, sizeof(level_state_t));
+    }
+}
+
+void level_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    level_state_t *state = (level_state_t *)context;
+    state->page = 0;
+    // activate runs again on the way out of low energy mode, without a resign; we've still got our claim from before.
+    if (!state->has_accelerometer) state->has_accelerometer = movement_claim_accelerometer();
+    if (state->has_accelerometer) {
+        movement_request_tick_frequency(4);
+        // with the watch in one hand, tapping it is easier than reaching for a button.
+        movement_enable_tap_detection();
+    }
+}
+
+bool level_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    (void) settings;
+    level_state_t *state = (level_state_t *)context;
+    switch (event.event_type) {
+        case EVENT_TIMEOUT:
+            movement_move_to_face(0);
+            break;
+        case EVENT_MODE_BUTTON_UP:
+            movement_move_to_next_face();
+            break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            movement_illuminate_led();
+            break;
+        case EVENT_ALARM_BUTTON_DOWN:
+        case EVENT_SINGLE_TAP:
+            state->page = (state->page + 1) % LEVEL_FACE_NUM_PAGES;
+            // fall through
+        case EVENT_ACTIVATE:
+        case EVENT_TICK:
+            _level_face_update_display(state);
+            break;
+        case EVENT_LOW_ENERGY_UPDATE:
+            // nobody's holding the watch level with the display asleep, and the I2C bus may be off.
+            watch_display_string("LV  SLEEP ", 0);
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+void level_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    level_state_t *state = (level_state_t *)context;
+    if (state->has_accelerometer) {
+        movement_request_tick_frequency(1);
+        movement_release_accelerometer();
+        state->has_accelerometer = false;
+    }
+}
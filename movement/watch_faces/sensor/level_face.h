@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef LEVEL_FACE_H_
+#define LEVEL_FACE_H_
+
+#include "movement.h"
+
+/*
+ * LEVEL
+ *
+ * Uses the accelerometer as a bubble level, updating four times a second. ALARM, or a tap on the crystal, steps
+ * through three pages:
+ *   LV: pitch and roll in degrees; both read 0 with the watch lying flat, display up.
+ *   TL: the total tilt away from flat, from 0 to 180 degrees.
+ *   OR: with the watch standing on its edge, which way is down, in degrees clockwise from 12 o'clock.
+ *       Lying flat, there's no such thing, and it shows dashes.
+ * Shows "none" if there's no accelerometer.
+ */
+
+typedef struct {
+    uint8_t page;
+    bool has_accelerometer;
+} level_state_t;
+
+void level_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void level_face_activate(movement_settings_t *settings, void *context);
+bool level_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void level_face_resign(movement_settings_t *settings, void *context);
+
+#define level_face ((const watch_face_t){ \
+    level_face_setup, \
+    level_face_activate, \
+    level_face_loop, \
+    level_face_resign, \
+    NULL, \
+    sizeof(level_state_t), \
+})
+
+#endif // LEVEL_FACE_H_
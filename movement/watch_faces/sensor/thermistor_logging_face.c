@@ -34,7 +34,7 @@ static void _thermistor_logging_face_log_data(thermistor_logger_state_t *logger_
     size_t pos = logger_state->data_points % THERMISTOR_LOGGING_NUM_DATA_POINTS;
 
     logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = thermistor_driver_get_temperature();
+    logger_state->data[pos].temperature = thermistor_driver_get_temperature_centi();
     logger_state->data_points++;
 
     thermistor_driver_disable();
@@ -62,11 +62,15 @@ static void _thermistor_logging_face_update_display(thermistor_logger_state_t *l
         }
         sprintf(buf, "AT%2d%2d%02d%02d", date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
     } else {
+        int temperature = logger_state->data[pos].temperature;
+        char unit = 'C';
         if (in_fahrenheit) {
-            sprintf(buf, "TL%2d%4.1f#F", logger_state->display_index, logger_state->data[pos].temperature_c * 1.8 + 32.0);
-        } else {
-            sprintf(buf, "TL%2d%4.1f#C", logger_state->display_index, logger_state->data[pos].temperature_c);
+            temperature = temperature * 9 / 5 + 3200;
+            unit = 'F';
         }
+        int tenths = (temperature + (temperature < 0 ? -5 : 5)) / 10;
+        if (tenths < 0 && tenths > -10) sprintf(buf, "TL%2d-0.%d#%c", logger_state->display_index, -tenths, unit);
+        else sprintf(buf, "TL%2d%2d.%d#%c", logger_state->display_index, tenths / 10, abs(tenths % 10), unit);
     }
 
     watch_display_string(buf, 0);
@@ -32,7 +32,7 @@
 
 typedef struct {
     watch_date_time timestamp;
-    float temperature_c;
+    int16_t temperature;    // hundredths of a degree Celsius
 } thermistor_logger_data_point_t;
 
 typedef struct {
@@ -54,6 +54,7 @@ bool thermistor_logging_face_wants_background_task(movement_settings_t *settings
     thermistor_logging_face_loop, \
     thermistor_logging_face_resign, \
     thermistor_logging_face_wants_background_task, \
+    sizeof(thermistor_logger_state_t), \
 })
 
 #endif // THERMISTOR_LOGGING_FACE_H_
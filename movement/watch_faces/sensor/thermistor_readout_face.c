@@ -30,13 +30,17 @@
 
 static void _thermistor_readout_face_update_display(bool in_fahrenheit) {
     thermistor_driver_enable();
-    float temperature_c = thermistor_driver_get_temperature();
+    int temperature = thermistor_driver_get_temperature_centi();
+    char unit = 'C';
     char buf[14];
     if (in_fahrenheit) {
-        sprintf(buf, "%4.1f#F", temperature_c * 1.8 + 32.0);
-    } else {
-        sprintf(buf, "%4.1f#C", temperature_c);
+        temperature = temperature * 9 / 5 + 3200;
+        unit = 'F';
     }
+    // round to tenths, and handle the sign ourselves for readings between 0 and -1.
+    int tenths = (temperature + (temperature < 0 ? -5 : 5)) / 10;
+    if (tenths < 0 && tenths > -10) sprintf(buf, "-0.%d#%c", -tenths, unit);
+    else sprintf(buf, "%2d.%d#%c", tenths / 10, abs(tenths % 10), unit);
     watch_display_string(buf, 4);
     thermistor_driver_disable();
 }
@@ -4,17 +4,24 @@ OBJS = $(addprefix $(BUILD)/, $(notdir %/$(subst .c,.o, $(SRCS))))
 
 SUBMODULES = tinyusb
 
-ifndef EMSCRIPTEN
+ifdef HOST
+all: directory $(BUILD)/$(BIN)
+else ifndef EMSCRIPTEN
 all: directory $(SUBMODULES) $(BUILD)/$(BIN).elf $(BUILD)/$(BIN).hex $(BUILD)/$(BIN).bin $(BUILD)/$(BIN).uf2 size
 else
 all: directory $(SUBMODULES) $(BUILD)/$(BIN).html
 endif
 
+$(BUILD)/$(BIN): $(OBJS)
+	@echo LD $@
+	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
+
 $(BUILD)/$(BIN).html: $(OBJS)
 	@echo HTML $@
 	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@ \
 		-s ASYNCIFY=1 \
-		-s EXPORTED_FUNCTIONS=_main \
+		-s EXPORTED_FUNCTIONS=_main,_malloc,_free \
+		-s EXPORTED_RUNTIME_METHODS=ccall,cwrap \
 		--shell-file=$(TOP)/watch-library/simulator/shell.html
 
 $(BUILD)/$(BIN).elf: $(OBJS)
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# Generates the ADC code to centi-degree lookup table in watch-library/shared/driver/thermistor_driver.c.
+# Pass the same parameters as thermistor_driver.h; the defaults match the Sensor Watch temperature board.
+# The divider math mirrors watch_utility_thermistor_temperature, so the table agrees with the float path.
+import argparse
+import math
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--b-coefficient", type=float, default=3380.0)
+parser.add_argument("--nominal-temperature", type=float, default=25.0)
+parser.add_argument("--nominal-resistance", type=float, default=10000.0)
+parser.add_argument("--series-resistance", type=float, default=10000.0)
+parser.add_argument("--low-side", action="store_true")
+parser.add_argument("--shift", type=int, default=10)
+args = parser.parse_args()
+
+
+def centidegrees(value):
+    if args.low_side:
+        if value <= 0:
+            return 32767
+        if value >= 65535:
+            return -32768
+        resistance = args.series_resistance / (65535.0 / value - 1.0)
+    else:
+        if value <= 0:
+            return -32768
+        resistance = (1023.0 * args.series_resistance) / (value / 64.0) - args.series_resistance
+        if resistance <= 0:
+            return 32767
+    reading = math.log(resistance / args.nominal_resistance) / args.b_coefficient
+    reading += 1.0 / (args.nominal_temperature + 273.15)
+    celsius = 1.0 / reading - 273.15
+    return max(-32768, min(32767, int(round(celsius * 100))))
+
+
+# the codes at the rails are an open or shorted divider, with no temperature to interpolate towards, so the table
+# runs from one step in from each end, and the driver clamps readings beyond that.
+step = 1 << args.shift
+entries = [centidegrees(i * step) for i in range(1, 65536 // step)]
+print("#define THERMISTOR_TABLE_SHIFT (%d)" % args.shift)
+print("static const int16_t thermistor_table[] = {")
+for i in range(0, len(entries), 8):
+    print("    " + " ".join("%d," % e for e in entries[i:i + 8]))
+print("};")
@@ -53,10 +53,12 @@ extern "C" {
 #include <stdbool.h>
 
 #ifndef __EMSCRIPTEN__
+#ifndef WATCH_HOST
 #ifndef _UNIT_TEST_
 #include "parts.h"
 #endif
 #endif
+#endif
 #include "err_codes.h"
 
 #ifdef __cplusplus
@@ -167,7 +167,8 @@ static inline uint32_t _get_cycles_for_us_internal(const uint16_t us, const uint
  */
 uint32_t _get_cycles_for_us(const uint16_t us)
 {
-	int32_t freq = hri_usbdevice_get_CTRLA_ENABLE_bit(USB) ? 8000000 : 4000000;
+	// the main clock runs from OSC16M, whose FSEL field selects 4, 8, 12 or 16 MHz.
+	int32_t freq = (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) + 1) * 4000000;
 	return _get_cycles_for_us_internal(us, freq, CPU_FREQ_POWER);
 }
 
@@ -197,6 +198,7 @@ static inline uint32_t _get_cycles_for_ms_internal(const uint16_t ms, const uint
  */
 uint32_t _get_cycles_for_ms(const uint16_t ms)
 {
-	int32_t freq = hri_usbdevice_get_CTRLA_ENABLE_bit(USB) ? 8000000 : 4000000;
+	// the main clock runs from OSC16M, whose FSEL field selects 4, 8, 12 or 16 MHz.
+	int32_t freq = (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) + 1) * 4000000;
 	return _get_cycles_for_ms_internal(ms, freq, CPU_FREQ_POWER);
 }
@@ -37,6 +37,7 @@
 #include <string.h>
 #include <utils.h>
 #include <utils_assert.h>
+#include <watch_profile.h>
 
 #ifdef __MINGW32__
 #define ffs __builtin_ffs
@@ -251,5 +252,6 @@ static void _ext_irq_handler(void)
  */
 void EIC_Handler(void)
 {
+	_watch_profile_wake();
 	_ext_irq_handler();
 }
@@ -73,6 +73,7 @@ int main(void) {
         bool usb_enabled = hri_usbdevice_get_CTRLA_ENABLE_bit(USB);
         bool can_sleep = app_loop();
 
+        if (can_sleep) _watch_profile_sleep();
         if (can_sleep && !usb_enabled) {
             app_prepare_for_standby();
             sleep(4);
@@ -23,21 +23,98 @@
  */
 
 #include "watch.h"
+#include "hpl_mclk_config.h"
+
+static volatile bool _watch_brownout_detected = false;
 
 // receives interrupts from MCLK, OSC32KCTRL, OSCCTRL, PAC, PM, SUPC and TAL, whatever that is.
 void SYSTEM_Handler(void) {
     if (SUPC->INTFLAG.bit.BOD33DET) {
-        // Our system voltage has dipped below 2.6V!
+        // Our system voltage has dipped below the brownout threshold!
         // Set the voltage regulator to work at low system voltage before we hit 2.5 V
         // This voltage regulator can carry us down to 1.62 volts as the battery drains.
         SUPC->VREG.bit.LPEFF = 0;
         // clear the interrupt condition
         SUPC->INTENCLR.bit.BOD33DET = 1;
-        // and disable the brownout detector (TODO: add a second, "power critical" brownout condition?)
-        SUPC->INTFLAG.reg &= ~SUPC_INTFLAG_BOD33DET;
+        // and disable the brownout detector until the app re-arms it with watch_configure_brownout_detector.
+        SUPC->INTFLAG.reg = SUPC_INTFLAG_BOD33DET;
+        _watch_brownout_detected = true;
+    }
+}
+
+void watch_configure_brownout_detector(uint16_t millivolts, uint8_t sample_interval) {
+    SUPC->INTENCLR.bit.BOD33DET = 1;
+    SUPC->BOD33.bit.ENABLE = 0;     // BOD33 must be disabled to change its configuration
+    while(!SUPC->STATUS.bit.B33SRDY);
+    if (millivolts == 0) return;
+
+    // the sampling clock is the 1 kHz ULP oscillator divided by 2^(PSEL + 1), so PSEL 9 is about once a second.
+    uint8_t psel = 9;
+    while (sample_interval > 1 && psel < SUPC_BOD33_PSEL_DIV65536_Val) {
+        sample_interval >>= 1;
+        psel++;
     }
+    SUPC->BOD33.bit.PSEL = psel;
+
+    // the threshold is 1.445V + level * 34mV.
+    if (millivolts < 1479) millivolts = 1479;
+    uint16_t level = (millivolts - 1445 + 17) / 34;
+    if (level > 63) level = 63;
+    SUPC->BOD33.bit.LEVEL = level;
+
+    SUPC->INTFLAG.reg = SUPC_INTFLAG_BOD33DET;
+    SUPC->INTENSET.bit.BOD33DET = 1;
+    SUPC->BOD33.bit.ENABLE = 1;
+}
+
+bool watch_get_brownout_detected(void) {
+    bool detected = _watch_brownout_detected;
+    _watch_brownout_detected = false;
+    return detected;
+}
+
+void watch_set_regulator_low_power_efficiency(bool enabled) {
+    SUPC->VREG.bit.LPEFF = enabled;
 }
 
 bool watch_is_buzzer_or_led_enabled(void){
     return hri_mclk_get_APBCMASK_TCC0_bit(MCLK);
 }
+
+static watch_performance_t _watch_performance = WATCH_PERFORMANCE_NORMAL;
+
+void watch_request_performance(watch_performance_t level) {
+    bool usb_enabled = hri_usbdevice_get_CTRLA_ENABLE_bit(USB);
+    uint8_t fsel;
+
+    if (level == WATCH_PERFORMANCE_HIGH) fsel = OSCCTRL_OSC16MCTRL_FSEL_16_Val;
+    else if (usb_enabled) fsel = OSCCTRL_OSC16MCTRL_FSEL_8_Val;
+    else fsel = OSCCTRL_OSC16MCTRL_FSEL_4_Val;
+
+    _watch_performance = level;
+    if (fsel == hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL)) return;
+
+    if (fsel == OSCCTRL_OSC16MCTRL_FSEL_16_Val) {
+        // raise the core voltage and add a flash wait state *before* speeding up...
+        hri_nvmctrl_write_CTRLB_RWS_bf(NVMCTRL, 1);
+        _set_performance_level(2);
+        hri_oscctrl_write_OSC16MCTRL_FSEL_bf(OSCCTRL, fsel);
+    } else {
+        // ...and only take them away after slowing back down. USB needs PL2 for the DFLL.
+        hri_oscctrl_write_OSC16MCTRL_FSEL_bf(OSCCTRL, fsel);
+        hri_nvmctrl_write_CTRLB_RWS_bf(NVMCTRL, CONF_NVM_WAIT_STATE);
+        if (!usb_enabled) _set_performance_level(0);
+    }
+    while (!hri_oscctrl_get_STATUS_OSC16MRDY_bit(OSCCTRL));
+
+    // now that the main clock has changed, anything that divides it down needs a new divider.
+    _watch_update_tcc_clock();
+    _watch_update_adc_clock();
+    _watch_update_uart_clock();
+    _watch_update_spi_clock();
+    _watch_profile_update_clock();
+}
+
+watch_performance_t watch_get_performance(void) {
+    return _watch_performance;
+}
@@ -24,11 +24,45 @@
 
 #include "watch_adc.h"
 #include "driver_init.h"
+#include "hpl_dma.h"
+
+// the DMA controller's write-back descriptors, from hpl_dmac.c; they hold a channel's progress once it's stopped.
+extern DmacDescriptor _write_back_section[DMAC_CH_NUM];
+
+static uint16_t *_watch_adc_sampling_buffer = NULL;
+static uint16_t _watch_adc_sampling_count;
+static watch_adc_sampling_cb_t _watch_adc_sampling_callback;
+static ext_irq_cb_t _watch_adc_window_callback;
+
+// the sequencer converts from the lowest input up, so results land here in that order; the order array says where
+// each of the caller's pins is in it.
+static uint16_t _watch_adc_scan_sequence[5];
+static uint8_t _watch_adc_scan_order[8];
+static uint16_t *_watch_adc_scan_results = NULL;
+static uint8_t _watch_adc_scan_count;
+static watch_adc_scan_cb_t _watch_adc_scan_callback;
 
 static void _watch_sync_adc(void) {
     while (ADC->SYNCBUSY.reg);
 }
 
+static int16_t _watch_get_analog_channel(const uint8_t pin) {
+    switch (pin) {
+        case A0:
+            return ADC_INPUTCTRL_MUXPOS_AIN12_Val;
+        case A1:
+            return ADC_INPUTCTRL_MUXPOS_AIN9_Val;
+        case A2:
+            return ADC_INPUTCTRL_MUXPOS_AIN10_Val;
+        case A3:
+            return ADC_INPUTCTRL_MUXPOS_AIN11_Val;
+        case A4:
+            return ADC_INPUTCTRL_MUXPOS_AIN8_Val;
+        default:
+            return -1;
+    }
+}
+
 static uint16_t _watch_get_analog_value(uint16_t channel) {
     if (ADC->INPUTCTRL.bit.MUXPOS != channel) {
         ADC->INPUTCTRL.bit.MUXPOS = channel;
@@ -41,6 +75,18 @@ static uint16_t _watch_get_analog_value(uint16_t channel) {
     return ADC->RESULT.reg;
 }
 
+static uint8_t _watch_get_adc_prescaler(void) {
+    // divide the main clock for a 500kHz ADC clock.
+    switch (_watch_get_main_clock_frequency()) {
+        case 16000000:
+            return ADC_CTRLB_PRESCALER_DIV32_Val;
+        case 8000000:
+            return ADC_CTRLB_PRESCALER_DIV16_Val;
+        default:
+            return ADC_CTRLB_PRESCALER_DIV8_Val;
+    }
+}
+
 void watch_enable_adc(void) {
     MCLK->APBCMASK.reg |= MCLK_APBCMASK_ADC;
     GCLK->PCHCTRL[ADC_GCLK_ID].reg = GCLK_PCHCTRL_GEN_GCLK0 | GCLK_PCHCTRL_CHEN;
@@ -58,14 +104,7 @@ void watch_enable_adc(void) {
     }
     _watch_sync_adc();
 
-    if (USB->DEVICE.CTRLA.bit.ENABLE) {
-        // if USB is enabled, we are running an 8 MHz clock.
-        // divide by 16 for a 500kHz ADC clock.
-        ADC->CTRLB.bit.PRESCALER = ADC_CTRLB_PRESCALER_DIV16_Val;
-    } else {
-        // otherwise it's 4 Mhz. divide by 8 for a 500kHz ADC clock.
-        ADC->CTRLB.bit.PRESCALER = ADC_CTRLB_PRESCALER_DIV8_Val;
-    }
+    ADC->CTRLB.bit.PRESCALER = _watch_get_adc_prescaler();
     ADC->CALIB.reg = calib_reg;
     ADC->REFCTRL.bit.REFSEL = ADC_REFCTRL_REFSEL_INTVCC2_Val;
     ADC->INPUTCTRL.bit.MUXNEG = ADC_INPUTCTRL_MUXNEG_GND_Val;
@@ -103,20 +142,10 @@ void watch_enable_analog_input(const uint8_t pin) {
 }
 
 uint16_t watch_get_analog_pin_level(const uint8_t pin) {
-    switch (pin) {
-        case A0:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN12_Val);
-        case A1:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN9_Val);
-        case A2:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN10_Val);
-        case A3:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN11_Val);
-        case A4:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN8_Val);
-        default:
-            return 0;
-    }
+    int16_t channel = _watch_get_analog_channel(pin);
+    if (channel < 0) return 0;
+
+    return _watch_get_analog_value(channel);
 }
 
 void watch_set_analog_num_samples(uint16_t samples) {
@@ -197,3 +226,233 @@ inline void watch_disable_adc(void) {
 
     MCLK->APBCMASK.reg &= ~MCLK_APBCMASK_ADC;
 }
+
+void _watch_update_adc_clock(void) {
+    if (!(MCLK->APBCMASK.reg & MCLK_APBCMASK_ADC)) return;
+    // the prescaler is enable-protected.
+    bool was_enabled = ADC->CTRLA.bit.ENABLE;
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+    ADC->CTRLB.bit.PRESCALER = _watch_get_adc_prescaler();
+    if (was_enabled) {
+        ADC->CTRLA.bit.ENABLE = 1;
+        _watch_sync_adc();
+    }
+}
+
+static void _watch_adc_run_in_standby(bool run) {
+    // RUNSTDBY and ONDEMAND are enable-protected.
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+    if (run) {
+        // the main clock stops in STANDBY, so give the ADC a generator of its own that keeps running. it divides the
+        // same OSC16M as the main clock (so the prescaler still works out), which only runs while the ADC asks for it.
+        OSCCTRL->OSC16MCTRL.bit.RUNSTDBY = 1;
+        GCLK->GENCTRL[WATCH_GCLK_ADC_SAMPLING].reg = GCLK_GENCTRL_SRC_OSC16M | GCLK_GENCTRL_DIV(1) | GCLK_GENCTRL_RUNSTDBY | GCLK_GENCTRL_GENEN;
+        while (GCLK->SYNCBUSY.reg & (GCLK_SYNCBUSY_GENCTRL0 << WATCH_GCLK_ADC_SAMPLING));
+        GCLK->PCHCTRL[ADC_GCLK_ID].reg = GCLK_PCHCTRL_GEN(WATCH_GCLK_ADC_SAMPLING) | GCLK_PCHCTRL_CHEN;
+        ADC->CTRLA.reg |= ADC_CTRLA_RUNSTDBY | ADC_CTRLA_ONDEMAND;
+        // the DMA controller reads the results now.
+        ADC->INTENCLR.reg = ADC_INTENCLR_RESRDY;
+        ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+    } else {
+        ADC->CTRLA.reg &= ~(ADC_CTRLA_RUNSTDBY | ADC_CTRLA_ONDEMAND);
+        ADC->INTENSET.reg = ADC_INTENSET_RESRDY;
+        GCLK->PCHCTRL[ADC_GCLK_ID].reg = GCLK_PCHCTRL_GEN_GCLK0 | GCLK_PCHCTRL_CHEN;
+    }
+    ADC->CTRLA.bit.ENABLE = 1;
+    _watch_sync_adc();
+    if (!run) {
+        GCLK->GENCTRL[WATCH_GCLK_ADC_SAMPLING].reg = 0;
+        OSCCTRL->OSC16MCTRL.bit.RUNSTDBY = 0;
+    }
+}
+
+static void _watch_adc_enable_dma(void (*done)(struct _dma_resource *), void (*error)(struct _dma_resource *)) {
+    // channel 0 is configured in hpl_dmac_config.h to move one half-word from the ADC to RAM per result.
+    struct _dma_resource *resource;
+    _dma_get_channel_resource(&resource, WATCH_DMA_CHANNEL_ADC);
+    resource->dma_cb.transfer_done = done;
+    resource->dma_cb.error = error;
+    _dma_set_source_address(WATCH_DMA_CHANNEL_ADC, (const void *)&ADC->RESULT.reg);
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_ADC, DMA_TRANSFER_COMPLETE_CB, true);
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_ADC, DMA_TRANSFER_ERROR_CB, true);
+}
+
+static void _watch_adc_disable_dma(void) {
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_ADC, DMA_TRANSFER_COMPLETE_CB, false);
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_ADC, DMA_TRANSFER_ERROR_CB, false);
+}
+
+static void _watch_adc_start_batch(void) {
+    _dma_set_destination_address(WATCH_DMA_CHANNEL_ADC, _watch_adc_sampling_buffer);
+    _dma_set_data_amount(WATCH_DMA_CHANNEL_ADC, _watch_adc_sampling_count);
+    _dma_enable_transaction(WATCH_DMA_CHANNEL_ADC, false);
+}
+
+static void _watch_adc_batch_done(struct _dma_resource *resource) {
+    (void) resource;
+    if (_watch_adc_sampling_buffer == NULL) return;
+    _watch_adc_sampling_callback(_watch_adc_sampling_buffer, _watch_adc_sampling_count);
+    // the callback may have stopped sampling; if not, the next batch starts over at the top of the buffer.
+    if (_watch_adc_sampling_buffer != NULL) _watch_adc_start_batch();
+}
+
+static void _watch_adc_batch_error(struct _dma_resource *resource) {
+    (void) resource;
+    // a bus error shouldn't happen reading the ADC into RAM; if it does, throw the batch away and carry on.
+    if (_watch_adc_sampling_buffer != NULL) _watch_adc_start_batch();
+}
+
+void watch_adc_start_sampling(const uint8_t pin, uint8_t frequency, uint16_t *buffer, uint16_t count, watch_adc_sampling_cb_t callback) {
+    int16_t channel = _watch_get_analog_channel(pin);
+    if (channel < 0 || __builtin_popcount(frequency) != 1 || buffer == NULL || count == 0 || callback == NULL) return;
+    if (_watch_adc_sampling_buffer != NULL) watch_adc_stop_sampling();
+
+    _watch_adc_sampling_buffer = buffer;
+    _watch_adc_sampling_count = count;
+    _watch_adc_sampling_callback = callback;
+
+    _watch_adc_run_in_standby(true);
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+    ADC->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+    ADC->INPUTCTRL.bit.MUXPOS = channel;
+    ADC->INTFLAG.reg = ADC_INTFLAG_WINMON;
+    ADC->CTRLA.bit.ENABLE = 1;
+    _watch_sync_adc();
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    _watch_adc_enable_dma(_watch_adc_batch_done, _watch_adc_batch_error);
+    _watch_adc_start_batch();
+
+    // finally, route the RTC's periodic event to the ADC's start input. the asynchronous path needs no clock.
+    MCLK->APBCMASK.reg |= MCLK_APBCMASK_EVSYS;
+    EVSYS->CHANNEL[WATCH_EVSYS_CHANNEL_ADC].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_RTC_PER_0 + __builtin_clz(frequency << 24)) |
+                                                  EVSYS_CHANNEL_PATH_ASYNCHRONOUS;
+    EVSYS->USER[EVSYS_ID_USER_ADC_START].reg = EVSYS_USER_CHANNEL(WATCH_EVSYS_CHANNEL_ADC + 1);
+    _watch_rtc_set_periodic_event(frequency);
+}
+
+void watch_adc_set_sampling_window(uint16_t lower, uint16_t upper, ext_irq_cb_t callback) {
+    ADC->INTENCLR.reg = ADC_INTENCLR_WINMON;
+    _watch_adc_window_callback = callback;
+    if (callback == NULL) {
+        ADC->CTRLC.bit.WINMODE = ADC_CTRLC_WINMODE_DISABLE_Val;
+        _watch_sync_adc();
+        return;
+    }
+
+    // the comparator is strict, so widen the window by one on each side to include the bounds.
+    ADC->WINLT.reg = lower ? lower - 1 : 0;
+    ADC->WINUT.reg = upper < 0xFFFF ? upper + 1 : 0xFFFF;
+    ADC->CTRLC.bit.WINMODE = ADC_CTRLC_WINMODE_MODE4_Val;
+    _watch_sync_adc();
+    ADC->INTFLAG.reg = ADC_INTFLAG_WINMON;
+    ADC->INTENSET.reg = ADC_INTENSET_WINMON;
+}
+
+uint16_t watch_adc_stop_sampling(void) {
+    if (_watch_adc_sampling_buffer == NULL) return 0;
+
+    _watch_rtc_set_periodic_event(0);
+    EVSYS->USER[EVSYS_ID_USER_ADC_START].reg = 0;
+    EVSYS->CHANNEL[WATCH_EVSYS_CHANNEL_ADC].reg = 0;
+
+    // stop the DMA channel and see how far it got through the batch.
+    _watch_adc_disable_dma();
+    DMAC->CHID.reg = WATCH_DMA_CHANNEL_ADC;
+    DMAC->CHCTRLA.bit.ENABLE = 0;
+    while (DMAC->CHCTRLA.bit.ENABLE);
+    uint16_t remaining = _write_back_section[WATCH_DMA_CHANNEL_ADC].BTCNT.reg;
+    uint16_t taken = remaining <= _watch_adc_sampling_count ? _watch_adc_sampling_count - remaining : 0;
+
+    NVIC_DisableIRQ(ADC_IRQn);
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+    ADC->EVCTRL.reg = 0;
+    ADC->CTRLC.bit.WINMODE = ADC_CTRLC_WINMODE_DISABLE_Val;
+    ADC->INTENCLR.reg = ADC_INTENCLR_WINMON;
+    _watch_adc_run_in_standby(false);
+
+    _watch_adc_sampling_buffer = NULL;
+    _watch_adc_window_callback = NULL;
+
+    return taken;
+}
+
+static void _watch_adc_finish_scan(void) {
+    _watch_adc_disable_dma();
+    ADC->SEQCTRL.reg = 0;
+    _watch_adc_run_in_standby(false);
+}
+
+static void _watch_adc_scan_done(struct _dma_resource *resource) {
+    (void) resource;
+    _watch_adc_finish_scan();
+    for (uint8_t i = 0; i < _watch_adc_scan_count; i++) _watch_adc_scan_results[i] = _watch_adc_scan_sequence[_watch_adc_scan_order[i]];
+    // clear the busy state first, so the callback can start another scan.
+    uint16_t *results = _watch_adc_scan_results;
+    _watch_adc_scan_results = NULL;
+    _watch_adc_scan_callback(results, _watch_adc_scan_count);
+}
+
+static void _watch_adc_scan_error(struct _dma_resource *resource) {
+    (void) resource;
+    // as with sampling, this shouldn't happen; if it does, give up on the scan rather than leave the ADC stuck, and
+    // tell the caller, who is waiting on the callback.
+    _watch_adc_finish_scan();
+    _watch_adc_scan_results = NULL;
+    _watch_adc_scan_callback(NULL, 0);
+}
+
+bool watch_adc_start_scan(const uint8_t *pins, uint8_t count, uint16_t *results, watch_adc_scan_cb_t callback) {
+    if (pins == NULL || count == 0 || count > sizeof(_watch_adc_scan_order) || results == NULL || callback == NULL) return false;
+    if (_watch_adc_sampling_buffer != NULL || _watch_adc_scan_results != NULL) return false;
+
+    // the sequencer takes a mask of inputs, one bit per MUXPOS value.
+    uint32_t sequence = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t channel = _watch_get_analog_channel(pins[i]);
+        if (channel < 0) return false;
+        sequence |= 1 << channel;
+    }
+    // each pin's result is preceded by one for every enabled input below it.
+    for (uint8_t i = 0; i < count; i++) {
+        _watch_adc_scan_order[i] = __builtin_popcount(sequence & ((1 << _watch_get_analog_channel(pins[i])) - 1));
+    }
+
+    _watch_adc_scan_results = results;
+    _watch_adc_scan_count = count;
+    _watch_adc_scan_callback = callback;
+
+    // let the ADC finish the scan on its own clock if the CPU goes to STANDBY in the meantime.
+    _watch_adc_run_in_standby(true);
+    ADC->SEQCTRL.reg = sequence;
+
+    _watch_adc_enable_dma(_watch_adc_scan_done, _watch_adc_scan_error);
+    _dma_set_destination_address(WATCH_DMA_CHANNEL_ADC, _watch_adc_scan_sequence);
+    _dma_set_data_amount(WATCH_DMA_CHANNEL_ADC, __builtin_popcount(sequence));
+    _dma_enable_transaction(WATCH_DMA_CHANNEL_ADC, false);
+
+    // one trigger runs the whole sequence.
+    ADC->SWTRIG.bit.START = 1;
+
+    return true;
+}
+
+bool watch_adc_is_busy(void) {
+    return _watch_adc_sampling_buffer != NULL || _watch_adc_scan_results != NULL;
+}
+
+void ADC_Handler(void) {
+    if (ADC->INTFLAG.bit.WINMON) {
+        // one shot: disarm the comparator before calling back, in case the callback re-arms it.
+        ADC->INTENCLR.reg = ADC_INTENCLR_WINMON;
+        ADC->INTFLAG.reg = ADC_INTFLAG_WINMON;
+        ext_irq_cb_t callback = _watch_adc_window_callback;
+        _watch_adc_window_callback = NULL;
+        if (callback != NULL) callback();
+    }
+}
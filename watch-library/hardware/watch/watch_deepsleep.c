@@ -140,7 +140,8 @@ static void _watch_disable_all_pins_except_rtc(void) {
 
 static void _watch_disable_all_peripherals_except_slcd(void) {
     _watch_disable_tcc();
-    watch_disable_adc();
+    // the ADC can sample in standby without the CPU, so leave it be if it's doing that.
+    if (!watch_adc_is_busy()) watch_disable_adc();
     watch_disable_external_interrupts();
     watch_disable_i2c();
     // TODO: replace this with a proper function when we remove the debug UART
@@ -161,19 +162,49 @@ void watch_enter_sleep_mode(void) {
     // disable all pins
     _watch_disable_all_pins_except_rtc();
 
+    _watch_profile_sleep();
+
     // enter standby (4); we basically hang out here until an interrupt wakes us.
     sleep(4);
 
     // and we awake! re-enable the brownout detector
     SUPC->INTENSET.bit.BOD33DET = 1;
 
+    // time app_setup with SysTick, which free-runs from the main clock, so the sleep policy knows what a wake costs.
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    uint32_t setup_start = SysTick->VAL;
+
     // call app_setup so the app can re-enable everything we disabled.
     app_setup();
 
+    // if app_setup called delay_ms, the delay driver reloaded SysTick and the count is meaningless; skip the sample.
+    if (SysTick->LOAD == 0xFFFFFF) {
+        uint32_t cycles = (setup_start - SysTick->VAL) & 0xFFFFFF;
+        _watch_record_sleep_mode_setup_time(cycles / (_watch_get_main_clock_frequency() / 1000000));
+    }
+
     // and call app_wake_from_standby (since main won't have a chance to do it)
     app_wake_from_standby();
 }
 
+void watch_enter_idle_mode(void) {
+    _watch_profile_sleep();
+
+    // enter idle (2); the main clock keeps running, and any interrupt wakes us.
+    sleep(2);
+}
+
+void watch_enter_standby_mode(void) {
+    app_prepare_for_standby();
+    _watch_profile_sleep();
+
+    // enter standby (4); unlike sleep mode, everything stays configured.
+    sleep(4);
+
+    app_wake_from_standby();
+}
+
 void watch_enter_deep_sleep_mode(void) {
     // identical to sleep mode except we disable the LCD first.
     slcd_sync_deinit(&SEGMENT_LCD_0);
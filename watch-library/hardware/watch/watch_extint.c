@@ -25,6 +25,8 @@
 #include "watch_extint.h"
 
 void watch_enable_external_interrupts(void) {
+    // if the EIC is already running, leave it be; starting it over would throw away every callback registered so far.
+    if (hri_mclk_get_APBAMASK_EIC_bit(MCLK) && hri_eic_get_CTRLA_ENABLE_bit(EIC)) return;
     // Configure EIC to use GCLK3 (the 32.768 kHz crystal)
     hri_gclk_write_PCHCTRL_reg(GCLK, EIC_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3_Val | (1 << GCLK_PCHCTRL_CHEN_Pos));
     // Enable AHB clock for the EIC
@@ -23,28 +23,78 @@
  */
 
 #include "watch_i2c.h"
+#include "hal_atomic.h"
+
+typedef struct {
+    int16_t addr;
+    const uint8_t *tx;
+    uint16_t tx_length;
+    uint8_t *rx;
+    uint16_t rx_length;
+    uint8_t data[2];    // register (and value) for write8 and read, so the caller needn't keep them around.
+    watch_i2c_cb_t callback;
+    void *context;
+} watch_i2c_transfer_t;
 
 struct io_descriptor *I2C_0_io;
 
+// the transfer at the head of the queue is the one on the bus.
+static watch_i2c_transfer_t _watch_i2c_queue[WATCH_I2C_QUEUE_LENGTH];
+static volatile uint8_t _watch_i2c_queue_head;
+static volatile uint8_t _watch_i2c_queue_count;
+// set while a blocking transfer has the bus; anything queued meanwhile waits for it to finish.
+static volatile bool _watch_i2c_sync_busy;
+
+static void _watch_i2c_start_transfer(void);
+
 void watch_enable_i2c(void) {
     I2C_0_init();
     i2c_m_sync_get_io_descriptor(&I2C_0, &I2C_0_io);
     i2c_m_sync_enable(&I2C_0);
+    // the SERCOM only interrupts while an asynchronous transfer is running; the blocking driver polls.
+    NVIC_ClearPendingIRQ(SERCOM1_IRQn);
+    NVIC_EnableIRQ(SERCOM1_IRQn);
 }
 
 void watch_disable_i2c(void) {
+    watch_i2c_wait();
+    NVIC_DisableIRQ(SERCOM1_IRQn);
     i2c_m_sync_disable(&I2C_0);
 	hri_mclk_clear_APBCMASK_SERCOM1_bit(MCLK);
 }
 
+// the blocking driver polls the same flags the interrupt handler takes, so an interrupt's callback mustn't start a
+// transfer under it. once the queue is empty, we hold the bus until _watch_i2c_end_sync hands it back.
+static void _watch_i2c_begin_sync(void) {
+    bool claimed = false;
+
+    while (!claimed) {
+        watch_i2c_wait();
+        CRITICAL_SECTION_ENTER();
+        if (_watch_i2c_queue_count == 0) claimed = _watch_i2c_sync_busy = true;
+        CRITICAL_SECTION_LEAVE();
+    }
+}
+
+static void _watch_i2c_end_sync(void) {
+    CRITICAL_SECTION_ENTER();
+    _watch_i2c_sync_busy = false;
+    if (_watch_i2c_queue_count) _watch_i2c_start_transfer();
+    CRITICAL_SECTION_LEAVE();
+}
+
 void watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {
+    _watch_i2c_begin_sync();
     i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
     io_write(I2C_0_io, buf, length);
+    _watch_i2c_end_sync();
 }
 
 void watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {
+    _watch_i2c_begin_sync();
     i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
     io_read(I2C_0_io, buf, length);
+    _watch_i2c_end_sync();
 }
 
 void watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {
@@ -91,3 +141,163 @@ uint32_t watch_i2c_read32(int16_t addr, uint8_t reg) {
 
     return data;
 }
+
+static void _watch_i2c_sync(void) {
+    while (SERCOM1->I2CM.SYNCBUSY.bit.SYSOP);
+}
+
+static void _watch_i2c_send_stop(void) {
+    SERCOM1->I2CM.CTRLB.bit.CMD = 3;
+    _watch_i2c_sync();
+}
+
+static void _watch_i2c_send_address(int16_t addr, bool read) {
+    SERCOM1->I2CM.ADDR.reg = (addr << 1) | read;
+    _watch_i2c_sync();
+}
+
+static void _watch_i2c_start_transfer(void) {
+    watch_i2c_transfer_t *transfer = &_watch_i2c_queue[_watch_i2c_queue_head];
+
+    // same as the blocking driver: smart mode, so that reading DATA acknowledges the byte and fetches the next one.
+    SERCOM1->I2CM.CTRLB.reg = (SERCOM1->I2CM.CTRLB.reg & ~SERCOM_I2CM_CTRLB_ACKACT) | SERCOM_I2CM_CTRLB_SMEN;
+    _watch_i2c_sync();
+    SERCOM1->I2CM.INTENSET.reg = SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR;
+    _watch_i2c_send_address(transfer->addr, transfer->tx_length == 0);
+}
+
+static void _watch_i2c_finish_transfer(int32_t status) {
+    watch_i2c_transfer_t *transfer = &_watch_i2c_queue[_watch_i2c_queue_head];
+    watch_i2c_cb_t callback = transfer->callback;
+    void *context = transfer->context;
+
+    _watch_i2c_queue_head = (_watch_i2c_queue_head + 1) % WATCH_I2C_QUEUE_LENGTH;
+    _watch_i2c_queue_count--;
+    // get the next transfer going before calling back, so the bus isn't idle while the callback runs.
+    if (_watch_i2c_queue_count) _watch_i2c_start_transfer();
+    else SERCOM1->I2CM.INTENCLR.reg = SERCOM_I2CM_INTENCLR_MASK;
+
+    if (callback != NULL) callback(status, context);
+}
+
+static bool _watch_i2c_enqueue(int16_t addr, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length,
+                               const uint8_t *data, watch_i2c_cb_t callback, void *context) {
+    bool queued = false;
+
+    CRITICAL_SECTION_ENTER();
+    if (_watch_i2c_queue_count < WATCH_I2C_QUEUE_LENGTH) {
+        watch_i2c_transfer_t *transfer = &_watch_i2c_queue[(_watch_i2c_queue_head + _watch_i2c_queue_count) % WATCH_I2C_QUEUE_LENGTH];
+        transfer->addr = addr;
+        if (data != NULL) {
+            transfer->data[0] = data[0];
+            transfer->data[1] = data[1];
+            tx = transfer->data;
+        }
+        transfer->tx = tx;
+        transfer->tx_length = tx_length;
+        transfer->rx = rx;
+        transfer->rx_length = rx_length;
+        transfer->callback = callback;
+        transfer->context = context;
+        // if nothing was running, nothing will pick this one up but us (or the blocking transfer that has the bus).
+        if (_watch_i2c_queue_count++ == 0 && !_watch_i2c_sync_busy) _watch_i2c_start_transfer();
+        queued = true;
+    }
+    CRITICAL_SECTION_LEAVE();
+
+    return queued;
+}
+
+bool watch_i2c_send_async(int16_t addr, const uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    if (buf == NULL || length == 0) return false;
+    return _watch_i2c_enqueue(addr, buf, length, NULL, 0, NULL, callback, context);
+}
+
+bool watch_i2c_receive_async(int16_t addr, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    if (buf == NULL || length == 0) return false;
+    return _watch_i2c_enqueue(addr, NULL, 0, buf, length, NULL, callback, context);
+}
+
+bool watch_i2c_write8_async(int16_t addr, uint8_t reg, uint8_t data, watch_i2c_cb_t callback, void *context) {
+    uint8_t buf[2] = {reg, data};
+    return _watch_i2c_enqueue(addr, NULL, 2, NULL, 0, buf, callback, context);
+}
+
+bool watch_i2c_read_async(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    if (buf == NULL || length == 0) return false;
+    uint8_t data[2] = {reg, 0};
+    return _watch_i2c_enqueue(addr, NULL, 1, buf, length, data, callback, context);
+}
+
+bool watch_i2c_is_busy(void) {
+    return _watch_i2c_queue_count != 0;
+}
+
+void watch_i2c_wait(void) {
+    while (_watch_i2c_queue_count) {
+        // with interrupts masked, a pending interrupt still wakes the CPU, so we can't sleep through the last one.
+        __disable_irq();
+        if (_watch_i2c_queue_count) watch_enter_idle_mode();
+        __enable_irq();
+    }
+}
+
+#define WATCH_I2C_STATUS_ERRORS (SERCOM_I2CM_STATUS_BUSERR | SERCOM_I2CM_STATUS_ARBLOST | SERCOM_I2CM_STATUS_LOWTOUT | \
+                                 SERCOM_I2CM_STATUS_MEXTTOUT | SERCOM_I2CM_STATUS_SEXTTOUT | SERCOM_I2CM_STATUS_LENERR)
+
+void SERCOM1_Handler(void) {
+    _watch_profile_wake();
+    uint8_t flags = SERCOM1->I2CM.INTFLAG.reg;
+    uint16_t status = SERCOM1->I2CM.STATUS.reg;
+    watch_i2c_transfer_t *transfer = &_watch_i2c_queue[_watch_i2c_queue_head];
+
+    if (flags & SERCOM_I2CM_INTFLAG_ERROR) {
+        // a bus error, lost arbitration, or a timeout (SCL held low, or a transfer running too long). MB or SB may be
+        // set along with it, or neither; either way, this transfer is over.
+        SERCOM1->I2CM.INTFLAG.reg = SERCOM_I2CM_INTFLAG_MASK;
+        if ((status & SERCOM_I2CM_STATUS_BUSSTATE_Msk) == SERCOM_I2CM_STATUS_BUSSTATE(2)) {
+            // we still own the bus, so let go of it properly.
+            _watch_i2c_send_stop();
+            SERCOM1->I2CM.STATUS.reg = status & WATCH_I2C_STATUS_ERRORS;
+        } else {
+            // otherwise, force the bus state back to idle, or the next transfer will wait for a stop that never comes.
+            SERCOM1->I2CM.STATUS.reg = (status & WATCH_I2C_STATUS_ERRORS) | SERCOM_I2CM_STATUS_BUSSTATE(1);
+        }
+        _watch_i2c_sync();
+        if (_watch_i2c_queue_count) _watch_i2c_finish_transfer(status & SERCOM_I2CM_STATUS_ARBLOST ? I2C_ERR_ARBLOST : I2C_ERR_BUS);
+        return;
+    }
+    if (_watch_i2c_queue_count == 0) return;
+
+    if (flags & SERCOM_I2CM_INTFLAG_MB) {
+        // master on bus: we're writing, or the device just answered (or didn't answer) its address.
+        if (status & SERCOM_I2CM_STATUS_RXNACK) {
+            _watch_i2c_send_stop();
+            _watch_i2c_finish_transfer(I2C_NACK);
+        } else if (transfer->tx_length) {
+            SERCOM1->I2CM.DATA.reg = *transfer->tx++;
+            _watch_i2c_sync();
+            transfer->tx_length--;
+        } else if (transfer->rx_length) {
+            // done writing the register address; a repeated start turns the bus around for the read.
+            _watch_i2c_send_address(transfer->addr, true);
+        } else {
+            _watch_i2c_send_stop();
+            _watch_i2c_finish_transfer(I2C_OK);
+        }
+    } else if (flags & SERCOM_I2CM_INTFLAG_SB) {
+        // slave on bus: a byte has arrived. for the last one, NACK and stop before the read of DATA acts on them.
+        bool last = --transfer->rx_length == 0;
+        if (last) {
+            SERCOM1->I2CM.CTRLB.reg = (SERCOM1->I2CM.CTRLB.reg | SERCOM_I2CM_CTRLB_ACKACT) & ~SERCOM_I2CM_CTRLB_SMEN;
+            _watch_i2c_sync();
+            _watch_i2c_send_stop();
+        }
+        *transfer->rx++ = SERCOM1->I2CM.DATA.reg;
+        _watch_i2c_sync();
+        if (last) {
+            SERCOM1->I2CM.INTFLAG.reg = SERCOM_I2CM_INTFLAG_SB;
+            _watch_i2c_finish_transfer(I2C_OK);
+        }
+    }
+}
@@ -37,6 +37,10 @@ void _watch_init(void) {
     SUPC->VREG.bit.SEL = 1;
     while(!SUPC->STATUS.bit.VREGRDY);
 
+    // The 4 MHz main clock doesn't need performance level 2; drop to PL0 unless USB needs it for the DFLL.
+    // watch_request_performance raises it again for bursts of heavy computation.
+    if (!hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) _set_performance_level(0);
+
     // check the battery voltage...
     watch_enable_adc();
     uint16_t battery_voltage = watch_get_vcc_voltage();
@@ -59,15 +63,12 @@ void _watch_init(void) {
     SUPC->BOD33.bit.RUNSTDBY = 1;   // Enable sampling mode in standby
     SUPC->BOD33.bit.STDBYCFG = 1;   // Run in standby
     SUPC->BOD33.bit.RUNBKUP = 0;    // Don't run in backup mode
-    SUPC->BOD33.bit.PSEL = 0x9;     // Check battery level every second (we'll change this before entering sleep)
-    SUPC->BOD33.bit.LEVEL = 34;     // Detect brownout at 2.6V (1.445V + level * 34mV)
     SUPC->BOD33.bit.ACTION = 0x2;   // Generate an interrupt when BOD33 is triggered
     SUPC->BOD33.bit.HYST = 0;       // Disable hysteresis
-    while(!SUPC->STATUS.bit.B33SRDY);
 
-    // Enable interrupt on BOD33 detect
-    SUPC->INTENSET.bit.BOD33DET = 1;
-    SUPC->BOD33.bit.ENABLE = 1;
+    // Detect brownout at 2.6V, checking the battery level every second. The app can retune both with
+    // watch_configure_brownout_detector, e.g. to sample less often while it sleeps.
+    watch_configure_brownout_detector(2600, 1);
 
     // External wake depends on RTC; calendar is a required module.
     _watch_rtc_init();
@@ -112,6 +113,23 @@ int getentropy(void *buf, size_t buflen) {
     return 0;
 }
 
+uint32_t _watch_get_main_clock_frequency(void) {
+    // GCLK0 runs directly from OSC16M, whose FSEL field selects 4, 8, 12 or 16 MHz.
+    return (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) + 1) * 4000000;
+}
+
+static uint32_t _watch_get_tcc_prescaler(void) {
+    // divide the main clock down to 1 MHz
+    switch (_watch_get_main_clock_frequency()) {
+        case 16000000:
+            return TCC_CTRLA_PRESCALER_DIV16;
+        case 8000000:
+            return TCC_CTRLA_PRESCALER_DIV8;
+        default:
+            return TCC_CTRLA_PRESCALER_DIV4;
+    }
+}
+
 void _watch_enable_tcc(void) {
     // clock TCC0 with the main clock (8 MHz) and enable the peripheral clock.
     hri_gclk_write_PCHCTRL_reg(GCLK, TCC0_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
@@ -122,13 +140,7 @@ void _watch_enable_tcc(void) {
     hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_SWRST);
     hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_SWRST);
     // divide the clock down to 1 MHz
-    if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
-        // if USB is enabled, we are running an 8 MHz clock.
-        hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_PRESCALER_DIV8);
-    } else {
-        // otherwise it's 4 Mhz.
-        hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_PRESCALER_DIV4);
-    }
+    hri_tcc_write_CTRLA_reg(TCC0, _watch_get_tcc_prescaler());
     // We're going to use normal PWM mode, which means period is controlled by PER, and duty cycle is controlled by
     // each compare channel's value:
     //  * Buzzer tones are set by setting PER to the desired period for a given frequency, and CC[1] to half of that
@@ -172,6 +184,16 @@ void _watch_disable_tcc(void) {
     hri_mclk_clear_APBCMASK_TCC0_bit(MCLK);
 }
 
+void _watch_update_tcc_clock(void) {
+    if (!hri_mclk_get_APBCMASK_TCC0_bit(MCLK)) return;
+    // the prescaler is enable-protected; PER and CC values survive the trip.
+    hri_tcc_clear_CTRLA_ENABLE_bit(TCC0);
+    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
+    hri_tcc_write_CTRLA_PRESCALER_bf(TCC0, _watch_get_tcc_prescaler() >> TCC_CTRLA_PRESCALER_Pos);
+    hri_tcc_set_CTRLA_ENABLE_bit(TCC0);
+    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
+}
+
 void _watch_enable_usb(void) {
     // disable USB, just in case.
     hri_usb_clear_CTRLA_ENABLE_bit(USB);
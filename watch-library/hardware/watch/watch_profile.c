@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "watch_profile.h"
+
+static watch_profile_histogram_t event_histograms[WATCH_PROFILE_NUM_EVENT_TYPES];
+static watch_profile_histogram_t face_histograms[WATCH_PROFILE_NUM_FACES];
+
+static bool _watch_profile_awake = false;
+static bool _watch_profile_tagged = false;
+static uint16_t _watch_profile_start;
+static uint8_t _watch_profile_event_type;
+static uint8_t _watch_profile_face_index;
+static uint8_t _watch_profile_shift;
+static uint16_t _watch_profile_carry;
+
+static void _watch_profile_enable_timer(void) {
+    // clock TC1 with the main clock on GCLK0 and enable the peripheral clock.
+    // TC0 is used for USB, and TC2 and TC3 are reserved for devices on the 9-pin connector.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC1_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC1_bit(MCLK);
+    // disable and reset TC1.
+    hri_tc_clear_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_SWRST);
+    // count in 16-bit mode at 250 kHz, one tick every 4 microseconds. no RUNSTDBY: we only want to count awake time.
+    switch (_watch_get_main_clock_frequency()) {
+        case 16000000:
+            hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64);
+            _watch_profile_shift = 0;
+            break;
+        case 8000000:
+            // there's no DIV32, so count at 500 kHz and halve the count when recording.
+            hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV16);
+            _watch_profile_shift = 1;
+            break;
+        default:
+            hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV16);
+            _watch_profile_shift = 0;
+            break;
+    }
+    hri_tc_set_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+}
+
+static uint16_t _watch_profile_read_timer(void) {
+    hri_tc_set_CTRLB_CMD_bf(TC1, TC_CTRLBSET_CMD_READSYNC_Val);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_CTRLB);
+    return hri_tccount16_read_COUNT_reg(TC1);
+}
+
+static uint16_t _watch_profile_elapsed(void) {
+    uint16_t end = _watch_profile_read_timer();
+    uint32_t ticks = _watch_profile_carry + ((uint16_t)(end - _watch_profile_start) >> _watch_profile_shift);
+    // if the counter wrapped and came back around past where we started, we've lost track; saturate.
+    if (hri_tc_get_INTFLAG_OVF_bit(TC1) && end >= _watch_profile_start) ticks = UINT16_MAX;
+    return ticks > UINT16_MAX ? UINT16_MAX : ticks;
+}
+
+static void _watch_profile_record(watch_profile_histogram_t *histogram, uint16_t ticks) {
+    uint8_t bucket = 0;
+    while ((ticks >> (bucket + 1)) && bucket < WATCH_PROFILE_NUM_BUCKETS - 1) bucket++;
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->total_ticks += ticks;
+    if (ticks > histogram->max_ticks) histogram->max_ticks = ticks;
+}
+
+void _watch_profile_wake(void) {
+    if (_watch_profile_awake) return;
+    // set up the timer on the first wake; check the bus clock first, since touching TC1 without it would fault.
+    if (!hri_mclk_get_APBCMASK_TC1_bit(MCLK) || !hri_tc_get_CTRLA_ENABLE_bit(TC1)) _watch_profile_enable_timer();
+    hri_tc_clear_INTFLAG_OVF_bit(TC1);
+    _watch_profile_start = _watch_profile_read_timer();
+    _watch_profile_carry = 0;
+    _watch_profile_awake = true;
+    _watch_profile_tagged = false;
+}
+
+void _watch_profile_sleep(void) {
+    if (!_watch_profile_awake) return;
+    _watch_profile_awake = false;
+    if (!_watch_profile_tagged) return;
+
+    uint16_t ticks = _watch_profile_elapsed();
+    _watch_profile_record(&event_histograms[_watch_profile_event_type], ticks);
+    _watch_profile_record(&face_histograms[_watch_profile_face_index], ticks);
+}
+
+void _watch_profile_update_clock(void) {
+    if (!hri_mclk_get_APBCMASK_TC1_bit(MCLK) || !hri_tc_get_CTRLA_ENABLE_bit(TC1)) return;
+    // bank what we've counted at the old rate, then start over at the new one.
+    if (_watch_profile_awake) _watch_profile_carry = _watch_profile_elapsed();
+    _watch_profile_enable_timer();
+    hri_tc_clear_INTFLAG_OVF_bit(TC1);
+    _watch_profile_start = _watch_profile_read_timer();
+}
+
+void watch_profile_set_event(uint8_t event_type, uint8_t face_index) {
+    if (!_watch_profile_awake || _watch_profile_tagged) return;
+    _watch_profile_event_type = event_type < WATCH_PROFILE_NUM_EVENT_TYPES ? event_type : WATCH_PROFILE_NUM_EVENT_TYPES - 1;
+    _watch_profile_face_index = face_index < WATCH_PROFILE_NUM_FACES ? face_index : WATCH_PROFILE_NUM_FACES - 1;
+    _watch_profile_tagged = true;
+}
+
+const watch_profile_histogram_t *watch_profile_get_event_histogram(uint8_t event_type) {
+    if (event_type >= WATCH_PROFILE_NUM_EVENT_TYPES) event_type = WATCH_PROFILE_NUM_EVENT_TYPES - 1;
+    return &event_histograms[event_type];
+}
+
+const watch_profile_histogram_t *watch_profile_get_face_histogram(uint8_t face_index) {
+    if (face_index >= WATCH_PROFILE_NUM_FACES) face_index = WATCH_PROFILE_NUM_FACES - 1;
+    return &face_histograms[face_index];
+}
+
+void watch_profile_reset(void) {
+    memset(event_histograms, 0, sizeof(event_histograms));
+    memset(face_histograms, 0, sizeof(face_histograms));
+}
+
+static void _watch_profile_print_histogram(const char *label, uint8_t index, const watch_profile_histogram_t *histogram) {
+    if (!histogram->count) return;
+    printf("%s %2d: n=%lu mean=%luus max=%luus |", label, index,
+           histogram->count,
+           (histogram->total_ticks / histogram->count) * WATCH_PROFILE_TICK_US,
+           (uint32_t)histogram->max_ticks * WATCH_PROFILE_TICK_US);
+    for(uint8_t i = 0; i < WATCH_PROFILE_NUM_BUCKETS; i++) printf(" %lu", histogram->buckets[i]);
+    printf("\n");
+}
+
+void watch_profile_print(void) {
+    printf("wake profile, %d us ticks, bucket n = 2^n ticks\n", WATCH_PROFILE_TICK_US);
+    for(uint8_t i = 0; i < WATCH_PROFILE_NUM_EVENT_TYPES; i++) _watch_profile_print_histogram("event", i, &event_histograms[i]);
+    for(uint8_t i = 0; i < WATCH_PROFILE_NUM_FACES; i++) _watch_profile_print_histogram("face", i, &face_histograms[i]);
+}
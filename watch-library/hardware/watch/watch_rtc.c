@@ -110,6 +110,18 @@ void watch_rtc_disable_all_periodic_callbacks(void) {
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 }
 
+void _watch_rtc_set_periodic_event(uint8_t frequency) {
+    uint32_t config = RTC->MODE2.EVCTRL.reg & ~RTC_MODE2_EVCTRL_PEREO_Msk;
+    if (__builtin_popcount(frequency) == 1) config |= RTC_MODE2_EVCTRL_PEREO0 << __builtin_clz(frequency << 24);
+
+    // the event control register is enable-protected.
+    RTC->MODE2.CTRLA.bit.ENABLE = 0;
+    _sync_rtc();
+    RTC->MODE2.EVCTRL.reg = config;
+    RTC->MODE2.CTRLA.bit.ENABLE = 1;
+    _sync_rtc();
+}
+
 void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time alarm_time, watch_rtc_alarm_match mask) {
     RTC->MODE2.Mode2Alarm[0].ALARM.reg = alarm_time.reg;
     RTC->MODE2.Mode2Alarm[0].MASK.reg = mask;
@@ -124,7 +136,8 @@ void watch_rtc_disable_alarm_callback(void) {
     RTC->MODE2.INTENCLR.reg = RTC_MODE2_INTENCLR_ALARM0;
 }
 
-void RTC_Handler(void) {
+WATCH_RAMFUNC void RTC_Handler(void) {
+    _watch_profile_wake();
     uint16_t interrupt_status = RTC->MODE2.INTFLAG.reg;
     uint16_t interrupt_enabled = RTC->MODE2.INTENSET.reg;
 
@@ -29,20 +29,37 @@
  //////////////////////////////////////////////////////////////////////////////////////////
 // Segmented Display
 
+// the frame rate with a clock divider of 1; CKDIV divides it further, from 1 to 8.
+#define WATCH_SLCD_BASE_FRAME_FREQUENCY (CONF_GCLK_SLCD_FREQUENCY / (((CONF_SLCD_PRESC + 1) * 16) * (CONF_SLCD_COM_NUM + 1)))
+
 static void _sync_slcd(void) {
     while (SLCD->SYNCBUSY.reg);
 }
 
+// most of the SLCD's configuration is enable-protected. the display memory survives a disable.
+static bool _watch_slcd_pause(void) {
+    bool was_enabled = SLCD->CTRLA.bit.ENABLE;
+    SLCD->CTRLA.bit.ENABLE = 0;
+    _sync_slcd();
+    return was_enabled;
+}
+
+static void _watch_slcd_resume(bool was_enabled) {
+    if (!was_enabled) return;
+    SLCD->CTRLA.bit.ENABLE = 1;
+    _sync_slcd();
+}
+
 void watch_enable_display(void) {
     SEGMENT_LCD_0_init();
     slcd_sync_enable(&SEGMENT_LCD_0);
 }
 
-inline void watch_set_pixel(uint8_t com, uint8_t seg) {
+WATCH_RAMFUNC void watch_set_pixel(uint8_t com, uint8_t seg) {
     slcd_sync_seg_on(&SEGMENT_LCD_0, SLCD_SEGID(com, seg));
 }
 
-inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
+WATCH_RAMFUNC void watch_clear_pixel(uint8_t com, uint8_t seg) {
     slcd_sync_seg_off(&SEGMENT_LCD_0, SLCD_SEGID(com, seg));
 }
 
@@ -52,14 +69,27 @@ void watch_clear_display(void) {
     SLCD->SDATAL2.reg = 0;
 }
 
+void watch_get_display_segments(uint32_t segments[3]) {
+    segments[0] = SLCD->SDATAL0.reg;
+    segments[1] = SLCD->SDATAL1.reg;
+    segments[2] = SLCD->SDATAL2.reg;
+}
+
+void watch_set_display_segments(const uint32_t segments[3]) {
+    SLCD->SDATAL0.reg = segments[0];
+    SLCD->SDATAL1.reg = segments[1];
+    SLCD->SDATAL2.reg = segments[2];
+}
+
 void watch_start_character_blink(char character, uint32_t duration) {
     SLCD->CTRLD.bit.FC0EN = 0;
     _sync_slcd();
 
-    if (duration <= SLCD_FC_BYPASS_MAX_MS) {
-        SLCD->FC0.reg = SLCD_FC0_PB | ((duration / (1000 / SLCD_FRAME_FREQUENCY)) - 1);
+    uint32_t frame_frequency = watch_get_display_frame_rate();
+    if (duration <= ((0x1F + 1) * (1000 / frame_frequency))) {
+        SLCD->FC0.reg = SLCD_FC0_PB | ((duration / (1000 / frame_frequency)) - 1);
     } else {
-        SLCD->FC0.reg = (((duration / (1000 / SLCD_FRAME_FREQUENCY)) / 8 - 1));
+        SLCD->FC0.reg = (((duration / (1000 / frame_frequency)) / 8 - 1));
     }
     SLCD->CTRLD.bit.FC0EN = 1;
 
@@ -87,7 +117,8 @@ void watch_stop_blink(void) {
 void watch_start_tick_animation(uint32_t duration) {
     watch_display_character(' ', 8);
     const uint32_t segs[] = { SLCD_SEGID(0, 2)};
-    slcd_sync_start_animation(&SEGMENT_LCD_0, segs, 1, duration);
+    // the HAL converts the duration to frames at the configured frame rate; scale it to the current one.
+    slcd_sync_start_animation(&SEGMENT_LCD_0, segs, 1, duration * watch_get_display_frame_rate() / SLCD_FRAME_FREQUENCY);
 }
 
 bool watch_tick_animation_is_running(void) {
@@ -99,3 +130,56 @@ void watch_stop_tick_animation(void) {
     slcd_sync_stop_animation(&SEGMENT_LCD_0, segs, 1);
     watch_display_character(' ', 8);
 }
+
+void watch_set_display_frame_rate(uint8_t hz) {
+    if (hz == 0) hz = 1;
+    int16_t ckdiv = (WATCH_SLCD_BASE_FRAME_FREQUENCY + hz / 2) / hz - 1;
+    if (ckdiv < 0) ckdiv = 0;
+    if (ckdiv > 7) ckdiv = 7;
+    if (SLCD->CTRLA.bit.CKDIV == ckdiv) return;
+
+    bool was_enabled = _watch_slcd_pause();
+    SLCD->CTRLA.bit.CKDIV = ckdiv;
+    _watch_slcd_resume(was_enabled);
+}
+
+uint8_t watch_get_display_frame_rate(void) {
+    return WATCH_SLCD_BASE_FRAME_FREQUENCY / (SLCD->CTRLA.bit.CKDIV + 1);
+}
+
+void watch_set_display_low_power_waveform(bool low_power) {
+    uint8_t wmod = low_power ? SLCD_CTRLA_WMOD_LP_Val : SLCD_CTRLA_WMOD_STD_Val;
+    if (SLCD->CTRLA.bit.WMOD == wmod) return;
+
+    bool was_enabled = _watch_slcd_pause();
+    SLCD->CTRLA.bit.WMOD = wmod;
+    _watch_slcd_resume(was_enabled);
+}
+
+void watch_set_display_contrast(uint8_t contrast) {
+    // unlike the rest, contrast can be adjusted on the fly.
+    SLCD->CTRLC.bit.CTST = contrast > 15 ? 15 : contrast;
+    _sync_slcd();
+}
+
+void watch_set_display_profile(watch_display_profile_t profile) {
+    bool was_enabled = _watch_slcd_pause();
+    switch (profile) {
+        case WATCH_DISPLAY_PROFILE_NORMAL:
+            SLCD->CTRLA.bit.CKDIV = CONF_SLCD_CKDIV;
+            SLCD->CTRLA.bit.WMOD = CONF_SLCD_WMOD;
+            SLCD->CTRLB.bit.BBD = CONF_SLCD_BBD - 1;
+            SLCD->CTRLC.bit.CTST = CONF_SLCD_CONTRAST_ADJUST;
+            break;
+        case WATCH_DISPLAY_PROFILE_LOW_POWER:
+            // ~32 Hz is about as slow as the glass will go without flickering.
+            SLCD->CTRLA.bit.CKDIV = 6;
+            SLCD->CTRLA.bit.WMOD = SLCD_CTRLA_WMOD_LP_Val;
+            // pulse the bias buffer for the minimum single cycle.
+            SLCD->CTRLB.bit.BBD = 0;
+            // a lower drive voltage is still legible, and the charge pump works less for it.
+            SLCD->CTRLC.bit.CTST = CONF_SLCD_CONTRAST_ADJUST > 4 ? CONF_SLCD_CONTRAST_ADJUST - 4 : 0;
+            break;
+    }
+    _watch_slcd_resume(was_enabled);
+}
@@ -23,32 +23,154 @@
  */
 
 #include "watch_spi.h"
+#include "driver_init.h"
+#include "hpl_dma.h"
+#include "hpl_sercom_config.h"
 
 struct io_descriptor *spi_io;
 
+static uint32_t _watch_spi_frequency = CONF_SERCOM_3_SPI_BAUD;
+static volatile bool _watch_spi_busy = false;
+static watch_spi_cb_t _watch_spi_callback;
+static void *_watch_spi_context;
+// a read clocks out 0xFF from here, and a write drops what comes back in here.
+static const uint8_t _watch_spi_fill = 0xFF;
+static uint8_t _watch_spi_discard;
+
+static uint8_t _watch_spi_get_baud_reg(uint32_t frequency) {
+    // the SPI clock is f_ref / (2 * (BAUD + 1)); rounding the divider up keeps us at or under the frequency asked for.
+    uint32_t divider = (_watch_get_main_clock_frequency() + 2 * frequency - 1) / (2 * frequency);
+
+    if (divider < 1) divider = 1;
+    if (divider > 256) divider = 256;
+
+    return divider - 1;
+}
+
+static void _watch_spi_write_baud_reg(void) {
+    // the baud register is enable-protected.
+    SERCOM3->SPI.CTRLA.reg &= ~SERCOM_SPI_CTRLA_ENABLE;
+    while (SERCOM3->SPI.SYNCBUSY.reg & SERCOM_SPI_SYNCBUSY_ENABLE);
+    SERCOM3->SPI.BAUD.reg = _watch_spi_get_baud_reg(_watch_spi_frequency);
+    SERCOM3->SPI.CTRLA.reg |= SERCOM_SPI_CTRLA_ENABLE;
+    while (SERCOM3->SPI.SYNCBUSY.reg & SERCOM_SPI_SYNCBUSY_ENABLE);
+}
+
 void watch_enable_spi(void) {
     SPI_0_init();
     spi_m_sync_get_io_descriptor(&SPI_0, &spi_io);
     spi_m_sync_enable(&SPI_0);
+    // the configured baud rate assumes a 4 MHz main clock; work it out for the one we've actually got.
+    _watch_spi_write_baud_reg();
 }
 
 void watch_disable_spi(void) {
+    watch_spi_wait();
     spi_m_sync_disable(&SPI_0);
     spi_io = NULL;
 }
 
 bool watch_spi_write(const uint8_t *buf, uint16_t length) {
+    watch_spi_wait();
 	return !!io_write(spi_io, buf, length);
 }
 
 bool watch_spi_read(uint8_t *buf, uint16_t length) {
+    watch_spi_wait();
 	return !!io_read(spi_io, buf, length);
 }
 
 bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
     struct spi_xfer xfer;
+    watch_spi_wait();
     xfer.txbuf = (uint8_t *)data_out;
     xfer.rxbuf = data_in;
     xfer.size = length;
     return !!spi_m_sync_transfer(&SPI_0, &xfer);
 }
+
+uint32_t watch_spi_set_frequency(uint32_t frequency) {
+    if (frequency == 0) return 0;
+    watch_spi_wait();
+    _watch_spi_frequency = frequency;
+    if (spi_io != NULL) _watch_spi_write_baud_reg();
+
+    return _watch_get_main_clock_frequency() / (2 * ((uint32_t)_watch_spi_get_baud_reg(frequency) + 1));
+}
+
+uint32_t watch_spi_get_frequency(void) {
+    return _watch_spi_frequency;
+}
+
+void _watch_update_spi_clock(void) {
+    // SERCOM3 is the UART when it isn't SPI.
+    if (spi_io == NULL || !(MCLK->APBCMASK.reg & MCLK_APBCMASK_SERCOM3)) return;
+    _watch_spi_write_baud_reg();
+}
+
+static void _watch_spi_finish(int32_t status) {
+    watch_spi_cb_t callback = _watch_spi_callback;
+
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_SPI_RX, DMA_TRANSFER_COMPLETE_CB, false);
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_SPI_RX, DMA_TRANSFER_ERROR_CB, false);
+    _watch_spi_busy = false;
+    if (callback != NULL) callback(status, _watch_spi_context);
+}
+
+static void _watch_spi_dma_done(struct _dma_resource *resource) {
+    (void) resource;
+    // every byte sent comes back with one received, so the receive channel finishing means the transfer is over.
+    _watch_spi_finish(0);
+}
+
+static void _watch_spi_dma_error(struct _dma_resource *resource) {
+    (void) resource;
+    DMAC->CHID.reg = WATCH_DMA_CHANNEL_SPI_TX;
+    DMAC->CHCTRLA.bit.ENABLE = 0;
+    while (DMAC->CHCTRLA.bit.ENABLE);
+    _watch_spi_finish(ERR_ABORTED);
+}
+
+bool watch_spi_transfer_async(const uint8_t *data_out, uint8_t *data_in, uint16_t length, watch_spi_cb_t callback, void *context) {
+    // channels 1 and 2 are configured in hpl_dmac_config.h to move one byte per SERCOM3 RX and TX trigger.
+    struct _dma_resource *resource;
+
+    if (spi_io == NULL || _watch_spi_busy || length == 0) return false;
+    _watch_spi_busy = true;
+    _watch_spi_callback = callback;
+    _watch_spi_context = context;
+
+    _dma_get_channel_resource(&resource, WATCH_DMA_CHANNEL_SPI_RX);
+    resource->dma_cb.transfer_done = _watch_spi_dma_done;
+    resource->dma_cb.error = _watch_spi_dma_error;
+    _dma_set_source_address(WATCH_DMA_CHANNEL_SPI_RX, (const void *)&SERCOM3->SPI.DATA.reg);
+    _dma_set_destination_address(WATCH_DMA_CHANNEL_SPI_RX, data_in != NULL ? data_in : &_watch_spi_discard);
+    _dma_dstinc_enable(WATCH_DMA_CHANNEL_SPI_RX, data_in != NULL);
+    _dma_set_data_amount(WATCH_DMA_CHANNEL_SPI_RX, length);
+
+    _dma_set_source_address(WATCH_DMA_CHANNEL_SPI_TX, data_out != NULL ? data_out : &_watch_spi_fill);
+    _dma_srcinc_enable(WATCH_DMA_CHANNEL_SPI_TX, data_out != NULL);
+    _dma_set_destination_address(WATCH_DMA_CHANNEL_SPI_TX, (void *)&SERCOM3->SPI.DATA.reg);
+    _dma_set_data_amount(WATCH_DMA_CHANNEL_SPI_TX, length);
+
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_SPI_RX, DMA_TRANSFER_COMPLETE_CB, true);
+    _dma_set_irq_state(WATCH_DMA_CHANNEL_SPI_RX, DMA_TRANSFER_ERROR_CB, true);
+    // the receive side has to be listening before the first byte goes out, or it could miss it.
+    _dma_enable_transaction(WATCH_DMA_CHANNEL_SPI_RX, false);
+    _dma_enable_transaction(WATCH_DMA_CHANNEL_SPI_TX, false);
+
+    return true;
+}
+
+bool watch_spi_is_busy(void) {
+    return _watch_spi_busy;
+}
+
+void watch_spi_wait(void) {
+    while (_watch_spi_busy) {
+        // with interrupts masked, a pending interrupt still wakes the CPU, so we can't sleep through the completion.
+        __disable_irq();
+        if (_watch_spi_busy) watch_enter_idle_mode();
+        __enable_irq();
+    }
+}
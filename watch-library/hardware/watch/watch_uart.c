@@ -28,6 +28,13 @@
 struct usart_sync_descriptor USART_0;
 struct io_descriptor *uart_io;
 
+// remembered so that the baud rate can be recalculated if the main clock changes.
+static uint32_t _watch_uart_baud = 0;
+
+static uint16_t _watch_uart_get_baud_reg(uint32_t baud) {
+    return (uint16_t)(65536 - ((65536 * 16.0f * baud) / _watch_get_main_clock_frequency()));
+}
+
 void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud) {
     SERCOM_USART_CTRLA_Type ctrla;
     SERCOM_USART_CTRLB_Type ctrlb;
@@ -93,13 +100,8 @@ void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud
     SERCOM3->USART.CTRLA.reg = ctrla.reg;
     SERCOM3->USART.CTRLB.reg = ctrlb.reg;
 
-    if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
-        uint64_t br = 65536 - ((65536 * 16.0f * baud) / 8000000);
-        SERCOM3->USART.BAUD.reg = (uint16_t)br;
-    } else {
-        uint64_t br = 65536 - ((65536 * 16.0f * baud) / 4000000);
-        SERCOM3->USART.BAUD.reg = (uint16_t)br;
-    }
+    _watch_uart_baud = baud;
+    SERCOM3->USART.BAUD.reg = _watch_uart_get_baud_reg(baud);
 
     SERCOM3->USART.CTRLA.reg |= SERCOM_USART_CTRLA_ENABLE;
 
@@ -117,6 +119,17 @@ char watch_uart_getc(void) {
     return retval;
 }
 
+void _watch_update_uart_clock(void) {
+    if (!_watch_uart_baud || !(MCLK->APBCMASK.reg & MCLK_APBCMASK_SERCOM3)) return;
+    if (!(SERCOM3->USART.CTRLA.reg & SERCOM_USART_CTRLA_ENABLE)) return;
+    // the baud register is enable-protected.
+    SERCOM3->USART.CTRLA.reg &= ~SERCOM_USART_CTRLA_ENABLE;
+    while (SERCOM3->USART.SYNCBUSY.reg & SERCOM_USART_SYNCBUSY_ENABLE);
+    SERCOM3->USART.BAUD.reg = _watch_uart_get_baud_reg(_watch_uart_baud);
+    SERCOM3->USART.CTRLA.reg |= SERCOM_USART_CTRLA_ENABLE;
+    while (SERCOM3->USART.SYNCBUSY.reg & SERCOM_USART_SYNCBUSY_ENABLE);
+}
+
 // Begin deprecated functions
 
  /*
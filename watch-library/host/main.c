@@ -0,0 +1,445 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Fleet runner for the host build: simulates many watches running the same firmware, spread across worker threads,
+// each against its own virtual clock, and reports what each one did and roughly how much charge it drew. e.g.
+//
+//   ./build/watch -n 1000 -j 8 -d 7 -r 20 > fleet.csv
+//
+// runs a thousand watches for a simulated week apiece, with about twenty random button presses an hour. Per-watch
+// stats go to stdout (or the file given with -o) as CSV, and a summary goes to stderr.
+//
+// Every watch runs the faces in movement_config.h with Movement's default settings unless -p names a profile file.
+// Each line of it describes one kind of watch: the indexes of the faces it has, in order, as positions in
+// watch_faces, and optionally the settings register it starts with, e.g.
+//
+//   0,1,3,4            # a clock, beats time and the settings faces
+//   0,2,3,4 0x1e90     # a clock and the voltage face, with the LED red and the buttons silent
+//
+// The watches take the profiles in turn, and the CSV says which one each had.
+//
+// With -c, it instead runs a single watch through a script and prints the display after every step, e.g.
+//
+//   ./build/watch -c "2s L A A+ 5*1m 2h M" > frames.txt
+//
+// Each step is a short press of M, L or A (a one second press with a +), or a wait: 10s, 5m, 2h. N* repeats a step.
+// The clock and the presses are fixed, so the output only changes when what's drawn does. Record it before touching
+// display or formatting code, then diff it afterwards. -f reads the script from a file instead, where # starts a
+// comment. -F starts the script on the face at that index in watch_faces, with only the first face behind it to come
+// back to (by MODE or a timeout), so the output doesn't depend on what else is built in. `make test` in movement/make
+// does this for every watch face against golden files; see movement/test.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "hpl_gpio.h"
+#include "pins.h"
+#include "watch_host.h"
+
+// a fresh CR2016, which is what Sensor Watch ships with.
+#define FLEET_BATTERY_CAPACITY (90000.0)
+
+#define SCRIPT_MAX_STEPS (4096)
+#define SCRIPT_SHORT_PRESS (100000000ull)
+#define SCRIPT_LONG_PRESS (WATCH_HOST_NS_PER_SECOND)
+// Movement can take a moment to finish drawing (changing faces beeps first, then activates the next one), so the
+// display is captured a little after each step rather than right as it ends.
+#define SCRIPT_SETTLE_TIME (250000000ull)
+
+#define FLEET_MAX_PROFILES (256)
+
+typedef struct {
+    uint8_t faces[WATCH_HOST_MAX_FACES];
+    uint8_t num_faces;
+    uint32_t settings;
+} fleet_profile_t;
+
+typedef struct {
+    uint32_t num_instances;
+    uint32_t seed;
+    uint32_t start_time;
+    uint64_t duration;
+    uint32_t presses_per_hour;
+    fleet_profile_t *profiles;
+    uint32_t num_profiles;
+    uint32_t next_instance;
+    watch_host_config_t *configs;
+    watch_host_stats_t *stats;
+} fleet_t;
+
+typedef struct {
+    fleet_t *fleet;
+    uint32_t instance;
+} fleet_job_t;
+
+static void *fleet_run_instance(void *arg) {
+    fleet_job_t *job = arg;
+    watch_host_run(&job->fleet->configs[job->instance], &job->fleet->stats[job->instance]);
+    return NULL;
+}
+
+static void *fleet_worker(void *arg) {
+    fleet_t *fleet = arg;
+    while (true) {
+        uint32_t instance = __atomic_fetch_add(&fleet->next_instance, 1, __ATOMIC_RELAXED);
+        if (instance >= fleet->num_instances) break;
+
+        // instance state is thread local and only initialized when a thread starts, so every watch gets a new one.
+        fleet_job_t job = { .fleet = fleet, .instance = instance };
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, fleet_run_instance, &job) != 0) {
+            fprintf(stderr, "could not start a thread for watch %u\n", instance);
+            exit(1);
+        }
+        pthread_join(thread, NULL);
+    }
+    return NULL;
+}
+
+static void fleet_usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n watches] [-j threads] [-d days] [-r presses per hour] [-s seed] [-t unix time] [-p profile file] [-o file]\n", name);
+    fprintf(stderr, "       %s -c script [-F face] [-t unix time] [-o file]\n", name);
+    fprintf(stderr, "       %s -f script file [-F face] [-t unix time] [-o file]\n", name);
+    exit(1);
+}
+
+// reads a comma separated list of face indexes, followed by the end of the string or whitespace.
+static bool fleet_parse_faces(const char *text, const char **end, uint8_t faces[WATCH_HOST_MAX_FACES], uint8_t *num_faces) {
+    *num_faces = 0;
+    while (true) {
+        char *after;
+        unsigned long face = strtoul(text, &after, 10);
+        if (after == text || face > UINT8_MAX || *num_faces == WATCH_HOST_MAX_FACES) return false;
+        faces[(*num_faces)++] = face;
+        text = after;
+        if (*text != ',') break;
+        text++;
+    }
+    *end = text;
+    return *text == 0 || *text == ' ' || *text == '\t' || *text == '\n' || *text == '#';
+}
+
+static bool fleet_read_profiles(fleet_t *fleet, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+    fleet->profiles = calloc(FLEET_MAX_PROFILES, sizeof(fleet_profile_t));
+    fleet->num_profiles = 0;
+    char line[512];
+    bool ok = fleet->profiles != NULL;
+    for (uint32_t line_number = 1; ok && fgets(line, sizeof(line), file) != NULL; line_number++) {
+        const char *text = line + strspn(line, " \t");
+        if (*text == '#' || *text == '\n' || *text == 0) continue;
+        if (fleet->num_profiles == FLEET_MAX_PROFILES) {
+            fprintf(stderr, "%s: more than %u profiles\n", path, FLEET_MAX_PROFILES);
+            ok = false;
+            break;
+        }
+        fleet_profile_t *profile = &fleet->profiles[fleet->num_profiles];
+        ok = fleet_parse_faces(text, &text, profile->faces, &profile->num_faces);
+        if (ok) {
+            text += strspn(text, " \t");
+            char *end = (char *)text;
+            if (*text != '#' && *text != '\n' && *text != 0) {
+                profile->settings = strtoul(text, &end, 0);
+                ok = end != text;
+                end += strspn(end, " \t");
+            }
+            ok = ok && (*end == '#' || *end == '\n' || *end == 0);
+        }
+        if (!ok) fprintf(stderr, "%s:%u: can't make sense of this profile\n", path, line_number);
+        fleet->num_profiles++;
+    }
+    fclose(file);
+    if (ok && fleet->num_profiles == 0) {
+        fprintf(stderr, "%s has no profiles in it\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+typedef struct {
+    char label[16];
+    uint8_t pin;            // the button to press, or 0 to just wait
+    uint64_t duration;      // how long to hold the button or wait, in nanoseconds
+} script_step_t;
+
+static script_step_t script_steps[SCRIPT_MAX_STEPS];
+static uint32_t script_num_steps;
+static FILE *script_output;
+
+static bool script_parse(const char *script) {
+    // step 0 is the display right after power-on.
+    strcpy(script_steps[0].label, "start");
+    script_num_steps = 1;
+
+    char *copy = strdup(script);
+    for (char *comment = strchr(copy, '#'); comment != NULL; comment = strchr(comment, '#')) {
+        while (*comment != 0 && *comment != '\n') *comment++ = ' ';
+    }
+    bool ok = true;
+    for (char *token = strtok(copy, " \t\n"); token != NULL && ok; token = strtok(NULL, " \t\n")) {
+        script_step_t step = {0};
+        unsigned long repeat = 1;
+        char *star = strchr(token, '*');
+        if (star != NULL) {
+            repeat = strtoul(token, NULL, 10);
+            token = star + 1;
+        }
+        snprintf(step.label, sizeof(step.label), "%s", token);
+
+        char *end;
+        unsigned long amount = strtoul(token, &end, 10);
+        if (end != token) {
+            uint64_t unit = *end == 's' ? 1 : *end == 'm' ? 60 : *end == 'h' ? 3600 : 0;
+            step.duration = amount * unit * WATCH_HOST_NS_PER_SECOND;
+            ok = unit != 0 && end[1] == 0;
+        } else {
+            step.pin = token[0] == 'M' ? BTN_MODE : token[0] == 'L' ? BTN_LIGHT : token[0] == 'A' ? BTN_ALARM : 0;
+            step.duration = token[1] == '+' ? SCRIPT_LONG_PRESS : SCRIPT_SHORT_PRESS;
+            ok = step.pin != 0 && (token[1] == 0 || (token[1] == '+' && token[2] == 0));
+        }
+        if (!ok) fprintf(stderr, "can't make sense of script step '%s'\n", token);
+
+        for (unsigned long i = 0; i < repeat && ok; i++) {
+            if (script_num_steps == SCRIPT_MAX_STEPS) {
+                fprintf(stderr, "script is too long\n");
+                ok = false;
+                break;
+            }
+            script_steps[script_num_steps++] = step;
+        }
+    }
+    free(copy);
+
+    return ok;
+}
+
+static void script_schedule_step(uint32_t index) {
+    uint64_t now = watch_host_get_time();
+    const script_step_t *step = &script_steps[index];
+    if (step->pin) watch_host_press_button(step->pin, now, step->duration);
+    watch_host_capture_display(now + step->duration + SCRIPT_SETTLE_TIME, index);
+}
+
+static void script_capture_callback(uint32_t index, const uint32_t segments[3]) {
+    uint64_t now = watch_host_get_time();
+    char text[11];
+    watch_host_read_display(segments, text);
+    fprintf(script_output, "%4u %-8s %10llu.%03llu %08x %08x %08x |%s|\n", index, script_steps[index].label,
+            (unsigned long long)(now / WATCH_HOST_NS_PER_SECOND),
+            (unsigned long long)(now % WATCH_HOST_NS_PER_SECOND / 1000000),
+            segments[0], segments[1], segments[2], text);
+
+    if (index + 1 == script_num_steps) watch_host_stop();
+    script_schedule_step(index + 1);
+}
+
+static void *script_run(void *arg) {
+    watch_host_config_t *config = arg;
+    watch_host_stats_t stats;
+    watch_host_capture_display(SCRIPT_SETTLE_TIME, 0);
+    watch_host_run(config, &stats);
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    fleet_t fleet = {
+        .num_instances = 1,
+        .seed = 1,
+        .start_time = 1640995200, // 2022-01-01 00:00:00
+        .duration = 24 * 60 * 60 * WATCH_HOST_NS_PER_SECOND,
+        .presses_per_hour = 0,
+    };
+    long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *output_path = NULL;
+    const char *script = NULL;
+    const char *script_path = NULL;
+    const char *profile_path = NULL;
+    long script_face = -1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:j:d:r:s:t:p:o:c:f:F:")) != -1) {
+        switch (opt) {
+            case 'n':
+                fleet.num_instances = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                num_threads = strtol(optarg, NULL, 10);
+                break;
+            case 'd':
+                fleet.duration = (uint64_t)(strtod(optarg, NULL) * 24 * 60 * 60 * WATCH_HOST_NS_PER_SECOND);
+                break;
+            case 'r':
+                fleet.presses_per_hour = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                fleet.seed = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                fleet.start_time = strtoul(optarg, NULL, 10);
+                break;
+            case 'p':
+                profile_path = optarg;
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'c':
+                script = optarg;
+                break;
+            case 'f':
+                script_path = optarg;
+                break;
+            case 'F':
+                script_face = strtol(optarg, NULL, 10);
+                if (script_face < 0 || script_face > UINT8_MAX) fleet_usage(argv[0]);
+                break;
+            default:
+                fleet_usage(argv[0]);
+        }
+    }
+    if (fleet.num_instances == 0 || fleet.duration == 0) fleet_usage(argv[0]);
+    if (num_threads < 1) num_threads = 1;
+    if ((uint32_t)num_threads > fleet.num_instances) num_threads = fleet.num_instances;
+
+    FILE *output = stdout;
+    if (output_path != NULL && (output = fopen(output_path, "w")) == NULL) {
+        perror(output_path);
+        return 1;
+    }
+
+    char *script_file = NULL;
+    if (script_path != NULL) {
+        FILE *file = fopen(script_path, "r");
+        if (file == NULL) {
+            perror(script_path);
+            return 1;
+        }
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        rewind(file);
+        script_file = calloc(1, length + 1);
+        if (script_file == NULL || fread(script_file, 1, length, file) != (size_t)length) {
+            fprintf(stderr, "could not read %s\n", script_path);
+            return 1;
+        }
+        fclose(file);
+        script = script_file;
+    }
+
+    if (script != NULL) {
+        if (!script_parse(script)) return 1;
+        watch_host_config_t config = {
+            .start_time = fleet.start_time,
+            .duration = UINT64_MAX,
+            .capture_callback = script_capture_callback,
+        };
+        if (script_face >= 0) config.faces[config.num_faces++] = 0;
+        if (script_face > 0) {
+            config.faces[config.num_faces++] = script_face;
+            config.first_face = 1;
+        }
+        // run it on a thread of its own like any other watch, so that it starts from a clean slate too.
+        pthread_t thread;
+        script_output = output;
+        pthread_create(&thread, NULL, script_run, &config);
+        pthread_join(thread, NULL);
+        if (output != stdout) fclose(output);
+        free(script_file);
+        return 0;
+    }
+
+    if (profile_path != NULL && !fleet_read_profiles(&fleet, profile_path)) return 1;
+
+    fleet.configs = calloc(fleet.num_instances, sizeof(watch_host_config_t));
+    fleet.stats = calloc(fleet.num_instances, sizeof(watch_host_stats_t));
+    pthread_t *workers = calloc(num_threads, sizeof(pthread_t));
+    if (fleet.configs == NULL || fleet.stats == NULL || workers == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < fleet.num_instances; i++) {
+        fleet.configs[i].instance = i;
+        fleet.configs[i].seed = fleet.seed;
+        // stagger the start times so the fleet doesn't all hit the same minute and hour boundaries in lockstep.
+        fleet.configs[i].start_time = fleet.start_time + (i * 7919) % 86400;
+        fleet.configs[i].duration = fleet.duration;
+        fleet.configs[i].presses_per_hour = fleet.presses_per_hour;
+        if (fleet.num_profiles) {
+            const fleet_profile_t *profile = &fleet.profiles[i % fleet.num_profiles];
+            memcpy(fleet.configs[i].faces, profile->faces, sizeof(profile->faces));
+            fleet.configs[i].num_faces = profile->num_faces;
+            fleet.configs[i].settings = profile->settings;
+        }
+    }
+
+    struct timespec started, finished;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    for (long i = 0; i < num_threads; i++) pthread_create(&workers[i], NULL, fleet_worker, &fleet);
+    for (long i = 0; i < num_threads; i++) pthread_join(workers[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &finished);
+
+    fprintf(output, "watch,profile,seconds,wakeups,loops,periodic_interrupts,alarm_interrupts,adc_interrupts,button_interrupts,button_presses,"
+                    "sleep_mode_entries,awake_seconds,idle_seconds,led_seconds,buzzer_seconds,charge_uah,average_ua\n");
+    double total_average = 0, min_average = 0, max_average = 0;
+    for (uint32_t i = 0; i < fleet.num_instances; i++) {
+        const watch_host_stats_t *stats = &fleet.stats[i];
+        double seconds = (double)stats->elapsed / WATCH_HOST_NS_PER_SECOND;
+        double charge = watch_host_get_charge(stats);
+        double average = charge * 3600.0 / seconds;
+        fprintf(output, "%u,%u,%.0f,%u,%u,%u,%u,%u,%u,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", i,
+                fleet.num_profiles ? i % fleet.num_profiles : 0, seconds,
+                stats->wakeups, stats->loops, stats->periodic_interrupts, stats->alarm_interrupts, stats->adc_interrupts,
+                stats->button_interrupts, stats->button_presses, stats->sleep_mode_entries,
+                (double)stats->awake / WATCH_HOST_NS_PER_SECOND, (double)stats->idle / WATCH_HOST_NS_PER_SECOND,
+                (double)stats->led_on / WATCH_HOST_NS_PER_SECOND,
+                (double)stats->buzzer_on / WATCH_HOST_NS_PER_SECOND, charge, average);
+        total_average += average;
+        if (i == 0 || average < min_average) min_average = average;
+        if (i == 0 || average > max_average) max_average = average;
+    }
+    if (output != stdout) fclose(output);
+
+    double mean_average = total_average / fleet.num_instances;
+    double wall = (finished.tv_sec - started.tv_sec) + (finished.tv_nsec - started.tv_nsec) / 1e9;
+    fprintf(stderr, "%u watches x %.2f days on %ld threads in %.2f s (%.0fx real time)\n", fleet.num_instances,
+            (double)fleet.duration / WATCH_HOST_NS_PER_SECOND / 86400, num_threads, wall,
+            (double)fleet.duration / WATCH_HOST_NS_PER_SECOND * fleet.num_instances / wall);
+    fprintf(stderr, "average current: mean %.2f uA, min %.2f uA, max %.2f uA (about %.0f days on a CR2016)\n",
+            mean_average, min_average, max_average, FLEET_BATTERY_CAPACITY / mean_average / 24);
+
+    free(workers);
+    free(fleet.stats);
+    free(fleet.configs);
+    free(fleet.profiles);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Joey Castillo
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_buzzer.h"
+#include "watch_host.h"
+
+static WATCH_INSTANCE_LOCAL bool buzzer_enabled = false;
+
+void watch_enable_buzzer(void) {
+    buzzer_enabled = true;
+}
+
+void watch_set_buzzer_period(uint32_t period) {
+    (void)period;
+}
+
+void watch_disable_buzzer(void) {
+    buzzer_enabled = false;
+    _watch_host_set_buzzer_on(false);
+}
+
+void watch_set_buzzer_on(void) {
+    if (!buzzer_enabled) return;
+    _watch_host_set_buzzer_on(true);
+}
+
+void watch_set_buzzer_off(void) {
+    if (!buzzer_enabled) return;
+    _watch_host_set_buzzer_on(false);
+}
+
+void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms) {
+    if (note == BUZZER_NOTE_REST) {
+        watch_set_buzzer_off();
+    } else {
+        watch_set_buzzer_period(NotePeriods[note]);
+        watch_set_buzzer_on();
+    }
+
+    // the firmware busy-waits here, so the CPU is billed as awake for the whole note.
+    _watch_host_delay(duration_ms * 1000000ull);
+    watch_set_buzzer_off();
+}
@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Joey Castillo
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_extint.h"
+#include "watch_host.h"
+
+static WATCH_INSTANCE_LOCAL uint32_t watch_backup_data[8];
+static WATCH_INSTANCE_LOCAL bool btn_alarm_extwake_enabled;
+static WATCH_INSTANCE_LOCAL bool btn_alarm_extwake_level;
+
+void watch_register_extwake_callback(uint8_t pin, ext_irq_cb_t callback, bool level) {
+    // only BTN_ALARM can be pressed on the host, so it's the only external wake source worth modeling.
+    if (pin == BTN_ALARM) {
+        btn_alarm_callback = callback;
+        btn_alarm_extwake_enabled = true;
+        btn_alarm_extwake_level = level;
+    }
+}
+
+void watch_disable_extwake_interrupt(uint8_t pin) {
+    if (pin == BTN_ALARM) {
+        btn_alarm_callback = NULL;
+        btn_alarm_extwake_enabled = false;
+    }
+}
+
+bool _watch_deepsleep_check_extwake(uint8_t pin, bool level) {
+    if (pin != BTN_ALARM || !btn_alarm_extwake_enabled || level != btn_alarm_extwake_level) return false;
+    if (btn_alarm_callback != NULL) btn_alarm_callback();
+    return true;
+}
+
+void watch_store_backup_data(uint32_t data, uint8_t reg) {
+    if (reg < 8) {
+        watch_backup_data[reg] = data;
+    }
+}
+
+uint32_t watch_get_backup_data(uint8_t reg) {
+    if (reg < 8) {
+        return watch_backup_data[reg];
+    }
+
+    return 0;
+}
+
+void watch_enter_sleep_mode(void) {
+    _watch_host_count_sleep_mode();
+
+    // disable the peripherals the firmware would, so that only the RTC and external wake can wake us.
+    watch_disable_external_interrupts();
+    watch_disable_leds();
+    watch_disable_buzzer();
+    watch_rtc_disable_all_periodic_callbacks();
+
+    // enter standby (4); we basically hang out here until an interrupt wakes us.
+    _watch_host_sleep();
+
+    // call app_setup so the app can re-enable everything we disabled.
+    app_setup();
+
+    // and call app_wake_from_standby (since main won't have a chance to do it)
+    app_wake_from_standby();
+}
+
+void watch_enter_idle_mode(void) {
+    // enter idle (2); the LED and buzzer keep going, and any interrupt wakes us.
+    _watch_host_idle();
+}
+
+void watch_enter_standby_mode(void) {
+    app_prepare_for_standby();
+
+    // enter standby (4); unlike sleep mode, everything stays configured.
+    _watch_host_sleep();
+
+    app_wake_from_standby();
+}
+
+void watch_enter_deep_sleep_mode(void) {
+    // identical to sleep mode except we disable the LCD first.
+    watch_clear_display();
+
+    watch_enter_sleep_mode();
+}
+
+void watch_enter_backup_mode(void) {
+    watch_rtc_disable_all_periodic_callbacks();
+    watch_disable_external_interrupts();
+    watch_disable_leds();
+    watch_disable_buzzer();
+    watch_clear_display();
+
+    // go into backup sleep mode (5). when we exit, the reset controller will take over.
+    _watch_host_sleep();
+    _watch_host_reset();
+}
+
+// deprecated
+void watch_enter_shallow_sleep(bool display_on) {
+    if (display_on) watch_enter_sleep_mode();
+    else watch_enter_deep_sleep_mode();
+}
+
+// deprecated
+void watch_enter_deep_sleep(void) {
+    watch_register_extwake_callback(BTN_ALARM, NULL, true);
+    watch_enter_backup_mode();
+}
@@ -0,0 +1,365 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+#include <setjmp.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_utility.h"
+#include "watch_host.h"
+#include "watch_spi_flash_model.h"
+
+typedef struct {
+    uint64_t at;
+    uint8_t pin;
+    bool level;
+} watch_host_button_edge_t;
+
+typedef enum {
+    HOST_EVENT_NONE = 0,
+    HOST_EVENT_RTC,
+    HOST_EVENT_BUTTON,
+    HOST_EVENT_RANDOM_PRESS,
+    HOST_EVENT_CAPTURE,
+    HOST_EVENT_ADC,
+    HOST_EVENT_I2C,
+} watch_host_event_t;
+
+static WATCH_INSTANCE_LOCAL const watch_host_config_t *host_config;
+static WATCH_INSTANCE_LOCAL watch_host_stats_t *host_stats;
+static WATCH_INSTANCE_LOCAL uint64_t host_now;
+static WATCH_INSTANCE_LOCAL jmp_buf host_finished;
+static WATCH_INSTANCE_LOCAL jmp_buf host_reset;
+
+static WATCH_INSTANCE_LOCAL watch_host_button_edge_t button_edges[WATCH_HOST_MAX_BUTTON_EDGES];
+static WATCH_INSTANCE_LOCAL uint8_t num_button_edges;
+static WATCH_INSTANCE_LOCAL uint32_t random_state;
+static WATCH_INSTANCE_LOCAL uint64_t next_random_press;
+
+static WATCH_INSTANCE_LOCAL bool capture_pending;
+static WATCH_INSTANCE_LOCAL uint64_t capture_at;
+static WATCH_INSTANCE_LOCAL uint32_t capture_id;
+
+static WATCH_INSTANCE_LOCAL bool led_on;
+static WATCH_INSTANCE_LOCAL uint64_t led_on_since;
+static WATCH_INSTANCE_LOCAL bool buzzer_on;
+static WATCH_INSTANCE_LOCAL uint64_t buzzer_on_since;
+
+static uint32_t _watch_host_random(void) {
+    // xorshift32; plenty for picking buttons, and the same seed always gives the same run.
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static void _watch_host_schedule_random_press(uint64_t after) {
+    if (host_config->presses_per_hour == 0) {
+        next_random_press = UINT64_MAX;
+        return;
+    }
+    // presses arrive as a Poisson process, so the gaps between them are exponentially distributed.
+    double u = (_watch_host_random() + 1.0) / 4294967297.0;
+    double mean = 3600.0 * WATCH_HOST_NS_PER_SECOND / host_config->presses_per_hour;
+    next_random_press = after + (uint64_t)(-log(u) * mean);
+}
+
+static void _watch_host_press_random_button(void) {
+    uint32_t r = _watch_host_random();
+    uint8_t pin;
+    // MODE gets the most use, then ALARM, then LIGHT; about one press in eight is a long press.
+    switch (r % 10) {
+        case 0: case 1: case 2: case 3: case 4:
+            pin = BTN_MODE;
+            break;
+        case 5: case 6: case 7:
+            pin = BTN_ALARM;
+            break;
+        default:
+            pin = BTN_LIGHT;
+            break;
+    }
+    uint64_t duration = ((r >> 8) % 8 == 0) ? 1500000000ull : 80000000ull + ((r >> 16) % 120) * 1000000ull;
+    watch_host_press_button(pin, host_now, duration);
+    _watch_host_schedule_random_press(host_now + duration);
+}
+
+static void _watch_host_stop_meters(void) {
+    if (led_on) host_stats->led_on += host_now - led_on_since;
+    if (buzzer_on) host_stats->buzzer_on += host_now - buzzer_on_since;
+    led_on_since = buzzer_on_since = host_now;
+}
+
+static void _watch_host_finish(uint64_t end, bool awake) __attribute__((noreturn));
+static void _watch_host_finish(uint64_t end, bool awake) {
+    if (awake) host_stats->awake += end - host_now;
+    host_now = end;
+    _watch_host_stop_meters();
+    host_stats->elapsed = host_now;
+    longjmp(host_finished, 1);
+}
+
+static uint64_t _watch_host_get_next_event(watch_host_event_t *type) {
+    uint64_t next = _watch_rtc_get_next_interrupt(host_now);
+    *type = next == UINT64_MAX ? HOST_EVENT_NONE : HOST_EVENT_RTC;
+
+    // on a tie, the RTC goes first; it only ever reports interrupts after host_now, so it can't be skipped over.
+    if (num_button_edges) {
+        uint64_t at = button_edges[0].at > host_now ? button_edges[0].at : host_now;
+        if (at < next) {
+            next = at;
+            *type = HOST_EVENT_BUTTON;
+        }
+    }
+    // a finished ADC scan calls back right away, as the DMA interrupt would.
+    if (_watch_adc_scan_pending() && host_now < next) {
+        next = host_now;
+        *type = HOST_EVENT_ADC;
+    }
+    // so does a queued I2C transfer; the bus is quick enough next to everything else here to take no time at all.
+    if (watch_i2c_is_busy() && host_now < next) {
+        next = host_now;
+        *type = HOST_EVENT_I2C;
+    }
+    if (next_random_press < next) {
+        next = next_random_press > host_now ? next_random_press : host_now;
+        *type = HOST_EVENT_RANDOM_PRESS;
+    }
+    // captures go last, so that they see the result of everything else that happened at the same time.
+    if (capture_pending) {
+        uint64_t at = capture_at > host_now ? capture_at : host_now;
+        if (at < next) {
+            next = at;
+            *type = HOST_EVENT_CAPTURE;
+        }
+    }
+
+    return next;
+}
+
+// services whatever is due at host_now, and returns true if any callback ran (i.e. the CPU would have woken up).
+static bool _watch_host_service_event(watch_host_event_t type) {
+    switch (type) {
+        case HOST_EVENT_RTC:
+        {
+            uint32_t periodic = 0, alarm = 0, adc = 0;
+            _watch_rtc_service_interrupts(host_now, &periodic, &alarm, &adc);
+            host_stats->periodic_interrupts += periodic;
+            host_stats->alarm_interrupts += alarm;
+            host_stats->adc_interrupts += adc;
+            return periodic || alarm || adc;
+        }
+        case HOST_EVENT_BUTTON:
+        {
+            watch_host_button_edge_t edge = button_edges[0];
+            num_button_edges--;
+            memmove(button_edges, button_edges + 1, num_button_edges * sizeof(watch_host_button_edge_t));
+            if (edge.level) host_stats->button_presses++;
+            if (_watch_extint_set_button(edge.pin, edge.level)) {
+                host_stats->button_interrupts++;
+                return true;
+            }
+            return false;
+        }
+        case HOST_EVENT_RANDOM_PRESS:
+            _watch_host_press_random_button();
+            return false;
+        case HOST_EVENT_CAPTURE:
+        {
+            uint32_t segments[3];
+            capture_pending = false;
+            watch_get_display_segments(segments);
+            if (host_config->capture_callback != NULL) host_config->capture_callback(capture_id, segments);
+            return false;
+        }
+        case HOST_EVENT_ADC:
+            if (_watch_adc_service_scan()) {
+                host_stats->adc_interrupts++;
+                return true;
+            }
+            return false;
+        case HOST_EVENT_I2C:
+            return _watch_i2c_service_transfer();
+        case HOST_EVENT_NONE:
+            break;
+    }
+    return false;
+}
+
+void watch_host_run(const watch_host_config_t *config, watch_host_stats_t *stats) {
+    memset(stats, 0, sizeof(watch_host_stats_t));
+    host_config = config;
+    host_stats = stats;
+    host_now = 0;
+    random_state = config->seed * 2654435761u + config->instance + 1;
+    if (random_state == 0) random_state = 1;
+    _watch_host_schedule_random_press(0);
+
+    watch_rtc_set_date_time(watch_utility_date_time_from_unix_time(config->start_time, 0));
+
+    if (setjmp(host_finished)) {
+        // the thread is about to go away, and its thread local pointers with it.
+        if (app_host_finish) app_host_finish();
+        spi_flash_model_close();
+        return;
+    }
+
+    // same sequence as the firmware's main(), minus USB.
+    bool woke_from_backup = setjmp(host_reset) != 0;
+    app_init();
+    if (woke_from_backup) app_wake_from_backup();
+    _watch_init();
+    app_setup();
+
+    while (true) {
+        bool can_sleep = app_loop();
+        host_stats->loops++;
+
+        if (can_sleep) {
+            app_prepare_for_standby();
+            _watch_host_sleep();
+            app_wake_from_standby();
+        } else {
+            // the firmware spins on app_loop here, servicing interrupts as they come in.
+            _watch_host_delay(WATCH_HOST_BUSY_LOOP_TIME);
+        }
+    }
+}
+
+uint64_t watch_host_get_time(void) {
+    return host_now;
+}
+
+const watch_host_config_t *watch_host_get_config(void) {
+    return host_config;
+}
+
+uint32_t watch_host_get_instance(void) {
+    return host_config->instance;
+}
+
+static bool _watch_host_insert_button_edge(uint8_t pin, uint64_t at, bool level) {
+    if (num_button_edges >= WATCH_HOST_MAX_BUTTON_EDGES) return false;
+    uint8_t i = num_button_edges;
+    while (i > 0 && button_edges[i - 1].at > at) {
+        button_edges[i] = button_edges[i - 1];
+        i--;
+    }
+    button_edges[i] = (watch_host_button_edge_t){ .at = at, .pin = pin, .level = level };
+    num_button_edges++;
+    return true;
+}
+
+bool watch_host_press_button(uint8_t pin, uint64_t at, uint64_t duration) {
+    if (pin != BTN_MODE && pin != BTN_LIGHT && pin != BTN_ALARM) return false;
+    if (num_button_edges + 2 > WATCH_HOST_MAX_BUTTON_EDGES) return false;
+    _watch_host_insert_button_edge(pin, at, true);
+    _watch_host_insert_button_edge(pin, at + duration, false);
+    return true;
+}
+
+void watch_host_capture_display(uint64_t at, uint32_t id) {
+    capture_pending = true;
+    capture_at = at;
+    capture_id = id;
+}
+
+void watch_host_stop(void) {
+    _watch_host_finish(host_now, false);
+}
+
+double watch_host_get_charge(const watch_host_stats_t *stats) {
+    double microamp_ns = WATCH_HOST_STANDBY_CURRENT * stats->elapsed
+                       + (WATCH_HOST_ACTIVE_CURRENT - WATCH_HOST_STANDBY_CURRENT) * stats->awake
+                       + (WATCH_HOST_IDLE_CURRENT - WATCH_HOST_STANDBY_CURRENT) * stats->idle
+                       + WATCH_HOST_LED_CURRENT * stats->led_on
+                       + WATCH_HOST_BUZZER_CURRENT * stats->buzzer_on;
+    return microamp_ns / (3600.0 * WATCH_HOST_NS_PER_SECOND);
+}
+
+void _watch_host_sleep(void) {
+    while (true) {
+        watch_host_event_t type;
+        uint64_t next = _watch_host_get_next_event(&type);
+        if (next > host_config->duration) _watch_host_finish(host_config->duration, false);
+        host_now = next;
+        if (_watch_host_service_event(type)) break;
+    }
+    host_stats->wakeups++;
+    host_stats->awake += WATCH_HOST_WAKE_TIME;
+}
+
+void _watch_host_idle(void) {
+    while (true) {
+        watch_host_event_t type;
+        uint64_t next = _watch_host_get_next_event(&type);
+        if (next > host_config->duration) {
+            host_stats->idle += host_config->duration - host_now;
+            _watch_host_finish(host_config->duration, false);
+        }
+        host_stats->idle += next - host_now;
+        host_now = next;
+        if (_watch_host_service_event(type)) break;
+    }
+}
+
+void _watch_host_delay(uint64_t duration) {
+    uint64_t until = host_now + duration;
+    while (true) {
+        watch_host_event_t type;
+        uint64_t next = _watch_host_get_next_event(&type);
+        if (next > until) break;
+        if (next > host_config->duration) _watch_host_finish(host_config->duration, true);
+        host_stats->awake += next - host_now;
+        host_now = next;
+        _watch_host_service_event(type);
+    }
+    if (until > host_config->duration) _watch_host_finish(host_config->duration, true);
+    host_stats->awake += until - host_now;
+    host_now = until;
+}
+
+void _watch_host_reset(void) {
+    _watch_host_stop_meters();
+    led_on = buzzer_on = false;
+    longjmp(host_reset, 1);
+}
+
+void _watch_host_set_led_on(bool on) {
+    if (on == led_on) return;
+    if (on) led_on_since = host_now;
+    else host_stats->led_on += host_now - led_on_since;
+    led_on = on;
+}
+
+void _watch_host_set_buzzer_on(bool on) {
+    if (on == buzzer_on) return;
+    if (on) buzzer_on_since = host_now;
+    else host_stats->buzzer_on += host_now - buzzer_on_since;
+    buzzer_on = on;
+}
+
+void _watch_host_count_sleep_mode(void) {
+    host_stats->sleep_mode_entries++;
+}
@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_HOST_H_INCLUDED
+#define _WATCH_HOST_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// The host backend runs Movement natively against a virtual clock, so that a whole fleet of watches can be simulated
+// in one process. Each watch runs on its own thread, and everything that belongs to it is WATCH_INSTANCE_LOCAL.
+// Nothing here waits on the wall clock: going to sleep jumps straight to the next RTC or button interrupt, and a busy
+// loop jumps there too (but is billed as awake time).
+
+#define WATCH_HOST_NS_PER_SECOND (1000000000ull)
+
+// Rough current draw used for the energy estimate, in microamps. Standby is the SAM L22 with the RTC and the segment
+// LCD running; idle is the main clock running with the CPU halted; active is the CPU at 4 MHz. The LED and buzzer
+// figures are on top of the active current.
+#define WATCH_HOST_STANDBY_CURRENT (4.0)
+#define WATCH_HOST_IDLE_CURRENT (60.0)
+#define WATCH_HOST_ACTIVE_CURRENT (200.0)
+#define WATCH_HOST_LED_CURRENT (2000.0)
+#define WATCH_HOST_BUZZER_CURRENT (1000.0)
+
+// How long the CPU is assumed to stay awake to service an interrupt and run app_loop once, in nanoseconds.
+#define WATCH_HOST_WAKE_TIME (250000ull)
+
+// How long one trip through app_loop takes when the firmware can't sleep and spins on it instead, in nanoseconds.
+#define WATCH_HOST_BUSY_LOOP_TIME (100000ull)
+
+#define WATCH_HOST_MAX_BUTTON_EDGES (64)
+#define WATCH_HOST_MAX_FACES (64)
+
+typedef struct {
+    uint32_t instance;              // this watch's index in the fleet
+    uint32_t seed;                  // seeds the random button presses
+    uint32_t start_time;            // what the RTC reads at power-on, as a UTC unix timestamp
+    uint64_t duration;              // how long to run, in virtual nanoseconds
+    uint32_t presses_per_hour;      // average rate of random button presses, or 0 to press only what was scripted
+    // called on the watch's thread with the display contents when a capture scheduled with watch_host_capture_display
+    // comes due. It may schedule more presses and captures, or call watch_host_stop.
+    void (*capture_callback)(uint32_t id, const uint32_t segments[3]);
+    // for the app. Movement runs the faces at these indexes into the watch_faces it was built with, in this order
+    // (or all of them, if num_faces is 0), with the one at position first_face on screen at power-on, and starts from
+    // these settings (or its defaults, if settings is 0).
+    uint8_t faces[WATCH_HOST_MAX_FACES];
+    uint8_t num_faces;
+    uint8_t first_face;
+    uint32_t settings;
+} watch_host_config_t;
+
+typedef struct {
+    uint64_t elapsed;               // virtual time simulated, in nanoseconds
+    uint64_t awake;                 // time spent out of standby, in nanoseconds
+    uint64_t idle;                  // time spent in IDLE (CPU halted, main clock running), in nanoseconds
+    uint64_t led_on;                // time the LED was lit, in nanoseconds
+    uint64_t buzzer_on;             // time the buzzer was sounding, in nanoseconds
+    uint32_t wakeups;               // times an interrupt woke the CPU from standby
+    uint32_t loops;                 // calls to app_loop
+    uint32_t periodic_interrupts;   // RTC periodic (tick) callbacks delivered
+    uint32_t alarm_interrupts;      // RTC alarm callbacks delivered
+    uint32_t adc_interrupts;        // ADC sampling batch, window and scan callbacks delivered
+    uint32_t button_interrupts;     // button callbacks delivered, including external wake
+    uint32_t button_presses;        // presses made, whether or not anything was listening
+    uint32_t sleep_mode_entries;    // calls to watch_enter_sleep_mode (i.e. trips through low energy mode)
+} watch_host_stats_t;
+
+/** Runs one watch on the calling thread from power-on until config->duration has elapsed, then returns its stats.
+  * Instance state is thread local and is never reset, so every watch needs a fresh thread.
+  */
+void watch_host_run(const watch_host_config_t *config, watch_host_stats_t *stats);
+
+/// Returns the current virtual time of the calling thread's watch, in nanoseconds since power-on.
+uint64_t watch_host_get_time(void);
+
+/// Returns the configuration the calling thread's watch is running with.
+const watch_host_config_t *watch_host_get_config(void);
+
+/// Returns the calling thread's watch's index in the fleet.
+uint32_t watch_host_get_instance(void);
+
+/// The app can define this to free what it allocated. It's called on the watch's thread when the run ends.
+void app_host_finish(void) __attribute__((weak));
+
+/** Schedules a press of BTN_MODE, BTN_LIGHT or BTN_ALARM at a virtual time (nanoseconds since power-on), held for
+  * duration nanoseconds. Call it before watch_host_run (the schedule is per thread) or from inside the watch.
+  * Returns false if the schedule is full.
+  */
+bool watch_host_press_button(uint8_t pin, uint64_t at, uint64_t duration);
+
+/** Schedules a capture of the display at a virtual time. It's taken after any interrupt due at the same time has been
+  * handled and app_loop has run, i.e. it shows what the firmware drew in response. Only one capture can be pending;
+  * scheduling another replaces it.
+  */
+void watch_host_capture_display(uint64_t at, uint32_t id);
+
+/** Reads the characters back off the display segments from a capture, for whoever's reading them; where several
+  * characters light the same segments it gives the first of them, and a ? where none does.
+  */
+void watch_host_read_display(const uint32_t segments[3], char text[11]);
+
+/// Ends the calling thread's run at the current virtual time; watch_host_run returns as if the duration had elapsed.
+void watch_host_stop(void) __attribute__((noreturn));
+
+/// Estimates the charge a watch drew over its run, in microamp-hours.
+double watch_host_get_charge(const watch_host_stats_t *stats);
+
+// The rest is the glue between the host peripherals and the virtual clock.
+
+/// Waits in standby until an interrupt is serviced.
+void _watch_host_sleep(void);
+
+/// Waits in IDLE until an interrupt is serviced.
+void _watch_host_idle(void);
+
+/// Busy-waits for duration nanoseconds, servicing interrupts as they come due.
+void _watch_host_delay(uint64_t duration);
+
+/// Simulates a reset, e.g. waking from BACKUP mode.
+void _watch_host_reset(void) __attribute__((noreturn));
+
+void _watch_host_set_led_on(bool on);
+void _watch_host_set_buzzer_on(bool on);
+void _watch_host_count_sleep_mode(void);
+
+/// Returns the virtual time of the next enabled RTC interrupt or event, or UINT64_MAX if there isn't one.
+uint64_t _watch_rtc_get_next_interrupt(uint64_t now);
+
+/// Calls every RTC callback and delivers every event that's due at now; returns how many [periodic, alarm] callbacks
+/// it called, and how many ADC callbacks the events led to.
+void _watch_rtc_service_interrupts(uint64_t now, uint32_t *periodic, uint32_t *alarm, uint32_t *adc);
+
+/// Drives a button pin and calls whatever is listening; returns true if any callback was called.
+bool _watch_extint_set_button(uint8_t pin, bool level);
+
+/// Calls the external wake callback for pin if level matches its trigger; returns true if it was called.
+bool _watch_deepsleep_check_extwake(uint8_t pin, bool level);
+
+#endif
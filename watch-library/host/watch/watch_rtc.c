@@ -0,0 +1,203 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Joey Castillo
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_rtc.h"
+#include "watch_utility.h"
+#include "watch_host.h"
+
+// the RTC counts whole seconds from 2020-01-01 00:00:00 after a reset; rtc_offset is the unix time at power-on.
+#define WATCH_HOST_RTC_RESET_TIME (1577836800)
+#define WATCH_HOST_RTC_PERIOD(per_n) ((WATCH_HOST_NS_PER_SECOND / 128) << (per_n))
+
+static WATCH_INSTANCE_LOCAL bool rtc_enabled = false;
+static WATCH_INSTANCE_LOCAL int64_t rtc_offset = WATCH_HOST_RTC_RESET_TIME;
+static WATCH_INSTANCE_LOCAL ext_irq_cb_t tick_callbacks[8];
+static WATCH_INSTANCE_LOCAL uint8_t tick_interrupts_enabled;
+static WATCH_INSTANCE_LOCAL uint8_t tick_events_enabled;
+
+static WATCH_INSTANCE_LOCAL ext_irq_cb_t alarm_callback;
+static WATCH_INSTANCE_LOCAL watch_date_time alarm_time;
+static WATCH_INSTANCE_LOCAL watch_rtc_alarm_match alarm_mask = ALARM_MATCH_DISABLED;
+WATCH_INSTANCE_LOCAL ext_irq_cb_t btn_alarm_callback;
+WATCH_INSTANCE_LOCAL ext_irq_cb_t a2_callback;
+WATCH_INSTANCE_LOCAL ext_irq_cb_t a4_callback;
+
+static int64_t _watch_rtc_get_seconds(uint64_t now) {
+    return rtc_offset + (int64_t)(now / WATCH_HOST_NS_PER_SECOND);
+}
+
+bool _watch_rtc_is_enabled(void) {
+    return rtc_enabled;
+}
+
+void _watch_rtc_init(void) {
+    rtc_enabled = true;
+}
+
+void watch_rtc_set_date_time(watch_date_time date_time) {
+    // like the real RTC, this sets the calendar but leaves the prescaler (and so the subsecond ticks) alone.
+    rtc_offset = (int64_t)watch_utility_date_time_to_unix_time(date_time, 0) - (int64_t)(watch_host_get_time() / WATCH_HOST_NS_PER_SECOND);
+}
+
+watch_date_time watch_rtc_get_date_time(void) {
+    return watch_utility_date_time_from_unix_time(_watch_rtc_get_seconds(watch_host_get_time()), 0);
+}
+
+void watch_rtc_register_tick_callback(ext_irq_cb_t callback) {
+    watch_rtc_register_periodic_callback(callback, 1);
+}
+
+void watch_rtc_disable_tick_callback(void) {
+    watch_rtc_disable_periodic_callback(1);
+}
+
+void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequency) {
+    // we told them, it has to be a power of 2.
+    if (__builtin_popcount(frequency) != 1) return;
+
+    // 0x01 (1 Hz) will have 7 leading zeros for PER7. 0x80 (128 Hz) will have no leading zeroes for PER0.
+    uint8_t per_n = __builtin_clz(frequency << 24);
+
+    tick_callbacks[per_n] = callback;
+    tick_interrupts_enabled |= 1 << per_n;
+}
+
+void watch_rtc_disable_periodic_callback(uint8_t frequency) {
+    if (__builtin_popcount(frequency) != 1) return;
+    uint8_t per_n = __builtin_clz(frequency << 24);
+    tick_interrupts_enabled &= ~(1 << per_n);
+}
+
+void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
+    tick_interrupts_enabled &= ~mask;
+}
+
+void watch_rtc_disable_all_periodic_callbacks(void) {
+    watch_rtc_disable_matching_periodic_callbacks(0xFF);
+}
+
+void _watch_rtc_set_periodic_event(uint8_t frequency) {
+    tick_events_enabled = (__builtin_popcount(frequency) == 1) ? 1 << __builtin_clz(frequency << 24) : 0;
+}
+
+void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time time, watch_rtc_alarm_match mask) {
+    alarm_callback = callback;
+    alarm_time = time;
+    alarm_mask = mask;
+}
+
+void watch_rtc_disable_alarm_callback(void) {
+    alarm_mask = ALARM_MATCH_DISABLED;
+}
+
+static uint64_t _watch_rtc_get_next_alarm(uint64_t now) {
+    int64_t period;
+    int64_t target = alarm_time.unit.second;
+    switch (alarm_mask) {
+        case ALARM_MATCH_SS:
+            period = 60;
+            break;
+        case ALARM_MATCH_MMSS:
+            period = 60 * 60;
+            target += alarm_time.unit.minute * 60;
+            break;
+        case ALARM_MATCH_HHMMSS:
+            period = 60 * 60 * 24;
+            target += alarm_time.unit.minute * 60 + alarm_time.unit.hour * 60 * 60;
+            break;
+        default:
+            return UINT64_MAX;
+    }
+
+    // after a match, the alarm fires at the next rising edge of CLK_RTC_CNT, i.e. one second later. So the next alarm
+    // is one second after the first matching second that is at or after the current one.
+    int64_t seconds = _watch_rtc_get_seconds(now);
+    int64_t match = seconds + (((target - seconds) % period) + period) % period;
+
+    return (uint64_t)(match + 1 - rtc_offset) * WATCH_HOST_NS_PER_SECOND;
+}
+
+uint64_t _watch_rtc_get_next_interrupt(uint64_t now) {
+    uint64_t next = _watch_rtc_get_next_alarm(now);
+
+    for (uint8_t per_n = 0; per_n < 8; per_n++) {
+        if (!((tick_interrupts_enabled | tick_events_enabled) & (1 << per_n))) continue;
+        uint64_t period = WATCH_HOST_RTC_PERIOD(per_n);
+        uint64_t tick = (now / period + 1) * period;
+        if (tick < next) next = tick;
+    }
+
+    return next;
+}
+
+void _watch_rtc_service_interrupts(uint64_t now, uint32_t *periodic, uint32_t *alarm, uint32_t *adc) {
+    // events go straight to the ADC without the CPU, which only wakes if the ADC calls back.
+    for (int8_t per_n = 7; per_n >= 0; per_n--) {
+        if ((tick_events_enabled & (1 << per_n)) && now % WATCH_HOST_RTC_PERIOD(per_n) == 0) {
+            if (_watch_adc_handle_sampling_event()) (*adc)++;
+        }
+    }
+    // same order as RTC_Handler: lowest frequency first, then the alarm.
+    for (int8_t per_n = 7; per_n >= 0; per_n--) {
+        if ((tick_interrupts_enabled & (1 << per_n)) && now % WATCH_HOST_RTC_PERIOD(per_n) == 0) {
+            if (tick_callbacks[per_n] != NULL) tick_callbacks[per_n]();
+            (*periodic)++;
+        }
+    }
+    // _watch_rtc_get_next_alarm(now - 1) is now itself if the alarm is due.
+    if (now > 0 && _watch_rtc_get_next_alarm(now - 1) == now) {
+        if (alarm_callback != NULL) alarm_callback();
+        (*alarm)++;
+    }
+}
+
+///////////////////////
+// Deprecated functions
+
+void watch_set_date_time(struct calendar_date_time date_time) {
+    watch_date_time val;
+    val.unit.second = date_time.time.sec;
+    val.unit.minute = date_time.time.min;
+    val.unit.hour = date_time.time.hour;
+    val.unit.day = date_time.date.day;
+    val.unit.month = date_time.date.month;
+    val.unit.year = date_time.date.year - WATCH_RTC_REFERENCE_YEAR;
+    watch_rtc_set_date_time(val);
+}
+
+void watch_get_date_time(struct calendar_date_time *date_time) {
+    if (date_time == NULL) return;
+    watch_date_time val = watch_rtc_get_date_time();
+    date_time->time.sec = val.unit.second;
+    date_time->time.min = val.unit.minute;
+    date_time->time.hour = val.unit.hour;
+    date_time->date.day = val.unit.day;
+    date_time->date.month = val.unit.month;
+    date_time->date.year = val.unit.year + WATCH_RTC_REFERENCE_YEAR;
+}
+
+void watch_register_tick_callback(ext_irq_cb_t callback) {
+    watch_rtc_register_tick_callback(callback);
+}
@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Joey Castillo
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_slcd.h"
+#include "watch_host.h"
+#include "watch_private_display.h"
+#include "hpl_slcd_config.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Segmented Display
+
+// The SLCD's blink and tick animations run in hardware without waking the CPU, so here they just show their first
+// frame; that keeps what's on the display a pure function of what the firmware did.
+static WATCH_INSTANCE_LOCAL bool blink_running;
+static WATCH_INSTANCE_LOCAL bool tick_running;
+static WATCH_INSTANCE_LOCAL uint32_t segment_data[3];
+
+void watch_enable_display(void) {
+    watch_clear_display();
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    segment_data[com] |= 1ul << seg;
+}
+
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    segment_data[com] &= ~(1ul << seg);
+}
+
+void watch_clear_display(void) {
+    segment_data[0] = segment_data[1] = segment_data[2] = 0;
+}
+
+void watch_get_display_segments(uint32_t segments[3]) {
+    for (uint8_t com = 0; com < 3; com++) segments[com] = segment_data[com];
+}
+
+void watch_set_display_segments(const uint32_t segments[3]) {
+    for (uint8_t com = 0; com < 3; com++) segment_data[com] = segments[com];
+}
+
+void watch_host_read_display(const uint32_t segments[3], char text[11]) {
+    for (uint8_t position = 0; position < Num_Chars; position++) {
+        uint64_t segmap = Segment_Map[position];
+        uint8_t present = 0, lit = 0;
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t com = (segmap & 0xFF) >> 6;
+            uint8_t seg = segmap & 0x3F;
+            if (com <= 2) {
+                present |= 1 << i;
+                if (segments[com] & (1ul << seg)) lit |= 1 << i;
+            }
+            segmap = segmap >> 8;
+        }
+        text[position] = '?';
+        for (uint8_t c = 0; c < sizeof(Character_Set); c++) {
+            if ((Character_Set[c] & present) == lit) {
+                text[position] = ' ' + c;
+                break;
+            }
+        }
+    }
+    text[Num_Chars] = 0;
+}
+
+void watch_start_character_blink(char character, uint32_t duration) {
+    (void)duration;
+    if (blink_running) return;
+    watch_display_character(character, 7);
+    watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    blink_running = true;
+}
+
+void watch_stop_blink(void) {
+    blink_running = false;
+}
+
+void watch_start_tick_animation(uint32_t duration) {
+    (void)duration;
+    if (tick_running) return;
+    watch_display_character(' ', 8);
+    watch_clear_pixel(0, 2);
+    watch_set_pixel(0, 3);
+    tick_running = true;
+}
+
+bool watch_tick_animation_is_running(void) {
+    return tick_running;
+}
+
+void watch_stop_tick_animation(void) {
+    tick_running = false;
+    watch_display_character(' ', 8);
+}
+
+// there's no glass to drive here; just keep track of the settings so the getters are honest.
+static WATCH_INSTANCE_LOCAL uint8_t display_frame_rate = SLCD_FRAME_FREQUENCY;
+
+void watch_set_display_frame_rate(uint8_t hz) {
+    if (hz == 0) hz = 1;
+    int16_t ckdiv = (SLCD_FRAME_FREQUENCY * (CONF_SLCD_CKDIV + 1) + hz / 2) / hz - 1;
+    if (ckdiv < 0) ckdiv = 0;
+    if (ckdiv > 7) ckdiv = 7;
+    display_frame_rate = SLCD_FRAME_FREQUENCY * (CONF_SLCD_CKDIV + 1) / (ckdiv + 1);
+}
+
+uint8_t watch_get_display_frame_rate(void) {
+    return display_frame_rate;
+}
+
+void watch_set_display_low_power_waveform(bool low_power) {
+    (void) low_power;
+}
+
+void watch_set_display_contrast(uint8_t contrast) {
+    (void) contrast;
+}
+
+void watch_set_display_profile(watch_display_profile_t profile) {
+    watch_set_display_frame_rate(profile == WATCH_DISPLAY_PROFILE_LOW_POWER ? 32 : SLCD_FRAME_FREQUENCY);
+}
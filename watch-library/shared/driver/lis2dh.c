@@ -22,24 +22,80 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "lis2dh.h"
 #include "watch.h"
 
+// RAM copy of CTRL1 through CTRL6, so the setters and getters don't each go out over I2C.
+#define LIS2DH_CTRL_COUNT (LIS2DH_REG_CTRL6 - LIS2DH_REG_CTRL1 + 1)
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dh_ctrl[LIS2DH_CTRL_COUNT];
+static WATCH_INSTANCE_LOCAL bool _lis2dh_ctrl_valid = false;
+static WATCH_INSTANCE_LOCAL bool _lis2dh_ctrl_deferred = false;
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dh_ctrl_dirty = 0;
+
+static void _lis2dh_load_ctrl(void) {
+    uint8_t reg = LIS2DH_REG_CTRL1 | 0x80; // set high bit for consecutive reads
+
+    watch_i2c_send(LIS2DH_ADDRESS, &reg, 1);
+    watch_i2c_receive(LIS2DH_ADDRESS, _lis2dh_ctrl, LIS2DH_CTRL_COUNT);
+    _lis2dh_ctrl_valid = true;
+}
+
+static uint8_t _lis2dh_read_ctrl(uint8_t reg) {
+    if (!_lis2dh_ctrl_valid) _lis2dh_load_ctrl();
+    return _lis2dh_ctrl[reg - LIS2DH_REG_CTRL1];
+}
+
+static void _lis2dh_write_ctrl(uint8_t reg, uint8_t val) {
+    if (!_lis2dh_ctrl_valid) _lis2dh_load_ctrl();
+    _lis2dh_ctrl[reg - LIS2DH_REG_CTRL1] = val;
+    if (_lis2dh_ctrl_deferred) _lis2dh_ctrl_dirty |= 1 << (reg - LIS2DH_REG_CTRL1);
+    else watch_i2c_write8(LIS2DH_ADDRESS, reg, val);
+}
+
 bool lis2dh_begin(void) {
     if (lis2dh_get_device_id() != LIS2DH_WHO_AM_I_VAL) {
         return false;
     }
+    // the sensor may have been power cycled since we last looked, so start from what it actually holds.
+    _lis2dh_ctrl_valid = false;
+    _lis2dh_ctrl_deferred = false;
+    _lis2dh_ctrl_dirty = 0;
+
+    lis2dh_begin_configuration();
     // Enable all axes, start at lowest possible data rate
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL1, LIS2DH_CTRL1_VAL_XEN |
-                                                       LIS2DH_CTRL1_VAL_YEN |
-                                                       LIS2DH_CTRL1_VAL_ZEN |
-                                                       LIS2DH_CTRL1_VAL_ODR_1HZ);
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL1, LIS2DH_CTRL1_VAL_XEN |
+                                         LIS2DH_CTRL1_VAL_YEN |
+                                         LIS2DH_CTRL1_VAL_ZEN |
+                                         LIS2DH_CTRL1_VAL_ODR_1HZ);
     // Set range to ±2G and enable block data update (output registers not updated until MSB and LSB have been read)
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL4, LIS2DH_CTRL4_VAL_BDU | LIS2DH_RANGE_2_G);
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL4, LIS2DH_CTRL4_VAL_BDU | LIS2DH_RANGE_2_G);
+    lis2dh_apply_configuration();
 
     return true;
 }
 
+void lis2dh_begin_configuration(void) {
+    _lis2dh_ctrl_deferred = true;
+}
+
+void lis2dh_apply_configuration(void) {
+    uint8_t buf[LIS2DH_CTRL_COUNT + 1];
+    uint8_t first = 0;
+    uint8_t last = LIS2DH_CTRL_COUNT - 1;
+
+    _lis2dh_ctrl_deferred = false;
+    if (!_lis2dh_ctrl_dirty) return;
+
+    // one write from the first changed register to the last; anything unchanged in between gets its shadowed value.
+    while (!(_lis2dh_ctrl_dirty & (1 << first))) first++;
+    while (!(_lis2dh_ctrl_dirty & (1 << last))) last--;
+    buf[0] = (LIS2DH_REG_CTRL1 + first) | 0x80; // set high bit for consecutive writes
+    memcpy(buf + 1, _lis2dh_ctrl + first, last - first + 1);
+    watch_i2c_send(LIS2DH_ADDRESS, buf, last - first + 2);
+    _lis2dh_ctrl_dirty = 0;
+}
+
 uint8_t lis2dh_get_device_id(void) {
     return watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_WHO_AM_I);
 }
@@ -91,50 +147,66 @@ lis2dh_reading lis2dh_get_raw_reading(void) {
 }
 
 void lis2dh_set_range(lis2dh_range_t range) {
-    uint8_t val = watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL4) & 0xCF;
+    uint8_t val = _lis2dh_read_ctrl(LIS2DH_REG_CTRL4) & 0xCF;
     uint8_t bits = range << 4;
 
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL4, val | bits);
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL4, val | bits);
 }
 
 lis2dh_range_t lis2dh_get_range(void) {
-    uint8_t retval = watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL4) & 0x30;
+    uint8_t retval = _lis2dh_read_ctrl(LIS2DH_REG_CTRL4) & 0x30;
     retval >>= 4;
     return (lis2dh_range_t)retval;
 }
 
 
 void lis2dh_set_data_rate(lis2dh_data_rate_t dataRate) {
-    uint8_t val = watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL1) & 0x0F;
+    uint8_t val = _lis2dh_read_ctrl(LIS2DH_REG_CTRL1) & 0x0F;
     uint8_t bits = dataRate << 4;
 
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL1, val | bits);
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL1, val | bits);
 }
 
 lis2dh_data_rate_t lis2dh_get_data_rate(void) {
-    return watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL1) >> 4;
+    return _lis2dh_read_ctrl(LIS2DH_REG_CTRL1) >> 4;
 }
 
 void lis2dh_configure_aoi_int1(lis2dh_interrupt_configuration configuration, uint8_t threshold, uint8_t duration, bool latch) {
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL3, LIS2DH_CTRL3_VAL_I1_AOI1);
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL3, LIS2DH_CTRL3_VAL_I1_AOI1);
     watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_INT1_CFG, configuration);
     watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_INT1_THS, threshold);
     watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_INT1_DUR, duration);
-    uint8_t val = watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL5) & 0xF7;
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL5, val | latch ? LIS2DH_CTRL5_VAL_LIR_INT1 : 0);
+    uint8_t val = _lis2dh_read_ctrl(LIS2DH_REG_CTRL5) & 0xF7;
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL5, val | (latch ? LIS2DH_CTRL5_VAL_LIR_INT1 : 0));
 }
 
 lis2dh_interrupt_state lis2dh_get_int1_state(void) {
     return (lis2dh_interrupt_state) watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_INT1_SRC);
 }
 
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dh_int1_src;
+static WATCH_INSTANCE_LOCAL lis2dh_interrupt_state_cb_t _lis2dh_int1_callback;
+
+static void _lis2dh_int1_src_read(int32_t status, void *context) {
+    (void) context;
+    if (status != 0) return;
+    _lis2dh_int1_callback((lis2dh_interrupt_state) _lis2dh_int1_src);
+}
+
+bool lis2dh_get_int1_state_async(lis2dh_interrupt_state_cb_t callback) {
+    if (callback == NULL) return false;
+
+    _lis2dh_int1_callback = callback;
+    return watch_i2c_read_async(LIS2DH_ADDRESS, LIS2DH_REG_INT1_SRC, &_lis2dh_int1_src, 1, _lis2dh_int1_src_read, NULL);
+}
+
 void lis2dh_configure_aoi_int2(lis2dh_interrupt_configuration configuration, uint8_t threshold, uint8_t duration, bool latch) {
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL6, LIS2DH_CTRL6_VAL_I2_INT2);
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL6, LIS2DH_CTRL6_VAL_I2_INT2);
     watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_INT2_CFG, configuration);
     watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_INT2_THS, threshold);
     watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_INT2_DUR, duration);
-    uint8_t val = watch_i2c_read8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL5) & 0xFD;
-    watch_i2c_write8(LIS2DH_ADDRESS, LIS2DH_REG_CTRL5, val | latch ? LIS2DH_CTRL5_VAL_LIR_INT2 : 0);
+    uint8_t val = _lis2dh_read_ctrl(LIS2DH_REG_CTRL5) & 0xFD;
+    _lis2dh_write_ctrl(LIS2DH_REG_CTRL5, val | (latch ? LIS2DH_CTRL5_VAL_LIR_INT2 : 0));
 }
 
 lis2dh_interrupt_state lis2dh_get_int2_state(void) {
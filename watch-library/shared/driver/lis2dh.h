@@ -84,8 +84,17 @@ typedef enum {
   LIS2DH_INTERRUPT_STATE_X_LOW  = 0b00000001, // X down
 } lis2dh_interrupt_state;
 
+/// Called with the contents of an interrupt source register once an asynchronous read of it completes.
+typedef void (*lis2dh_interrupt_state_cb_t)(lis2dh_interrupt_state state);
+
 bool lis2dh_begin(void);
 
+// The driver keeps a copy of CTRL1-CTRL6, so the getters below cost no bus traffic and each setter is a single write.
+// Between these two calls, setters only update that copy; apply then writes every changed register in one burst.
+void lis2dh_begin_configuration(void);
+
+void lis2dh_apply_configuration(void);
+
 uint8_t lis2dh_get_device_id(void);
 
 bool lis2dh_have_new_data(void);
@@ -106,6 +115,10 @@ void lis2dh_configure_aoi_int1(lis2dh_interrupt_configuration configuration, uin
 
 lis2dh_interrupt_state lis2dh_get_int1_state(void);
 
+// Reads INT1_SRC over asynchronous I2C, which also releases a latched INT1, and passes it to callback from interrupt
+// context. Safe to call from an interrupt callback; returns false if the transfer couldn't be queued.
+bool lis2dh_get_int1_state_async(lis2dh_interrupt_state_cb_t callback);
+
 void lis2dh_configure_aoi_int2(lis2dh_interrupt_configuration configuration, uint8_t threshold, uint8_t duration, bool latch);
 
 lis2dh_interrupt_state lis2dh_get_int2_state(void);
@@ -22,25 +22,81 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "lis2dw.h"
 #include "watch.h"
 
+// RAM copy of CTRL1 through CTRL6, so the setters and getters don't each go out over I2C.
+#define LIS2DW_CTRL_COUNT (LIS2DW_REG_CTRL6 - LIS2DW_REG_CTRL1 + 1)
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_ctrl[LIS2DW_CTRL_COUNT];
+static WATCH_INSTANCE_LOCAL bool _lis2dw_ctrl_valid = false;
+static WATCH_INSTANCE_LOCAL bool _lis2dw_ctrl_deferred = false;
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_ctrl_dirty = 0;
+
+static void _lis2dw_load_ctrl(void) {
+    uint8_t reg = LIS2DW_REG_CTRL1 | 0x80; // set high bit for consecutive reads
+
+    watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
+    watch_i2c_receive(LIS2DW_ADDRESS, _lis2dw_ctrl, LIS2DW_CTRL_COUNT);
+    _lis2dw_ctrl_valid = true;
+}
+
+static uint8_t _lis2dw_read_ctrl(uint8_t reg) {
+    if (!_lis2dw_ctrl_valid) _lis2dw_load_ctrl();
+    return _lis2dw_ctrl[reg - LIS2DW_REG_CTRL1];
+}
+
+static void _lis2dw_write_ctrl(uint8_t reg, uint8_t val) {
+    if (!_lis2dw_ctrl_valid) _lis2dw_load_ctrl();
+    _lis2dw_ctrl[reg - LIS2DW_REG_CTRL1] = val;
+    if (_lis2dw_ctrl_deferred) _lis2dw_ctrl_dirty |= 1 << (reg - LIS2DW_REG_CTRL1);
+    else watch_i2c_write8(LIS2DW_ADDRESS, reg, val);
+}
+
 bool lis2dw_begin(void) {
     if (lis2dw_get_device_id() != LIS2DW_WHO_AM_I_VAL) {
         return false;
     }
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BOOT);
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_SOFT_RESET);
+    // the reset put every register back to its default, so forget what we had.
+    _lis2dw_ctrl_valid = false;
+    _lis2dw_ctrl_deferred = false;
+    _lis2dw_ctrl_dirty = 0;
+
+    lis2dw_begin_configuration();
     // Start at lowest possible data rate and lowest possible power mode
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, LIS2DW_CTRL1_VAL_ODR_LOWEST | LIS2DW_CTRL1_VAL_MODE_LOW_POWER | LIS2DW_CTRL1_VAL_LPMODE_1);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL1, LIS2DW_CTRL1_VAL_ODR_LOWEST | LIS2DW_CTRL1_VAL_MODE_LOW_POWER | LIS2DW_CTRL1_VAL_LPMODE_1);
     // Enable block data update (output registers not updated until MSB and LSB have been read) and address autoincrement
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BDU | LIS2DW_CTRL2_VAL_IF_ADD_INC);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BDU | LIS2DW_CTRL2_VAL_IF_ADD_INC);
     // Set range to ±2G
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6, LIS2DW_CTRL6_VAL_RANGE_2G);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL6, LIS2DW_CTRL6_VAL_RANGE_2G);
+    lis2dw_apply_configuration();
 
     return true;
 }
 
+void lis2dw_begin_configuration(void) {
+    _lis2dw_ctrl_deferred = true;
+}
+
+void lis2dw_apply_configuration(void) {
+    uint8_t buf[LIS2DW_CTRL_COUNT + 1];
+    uint8_t first = 0;
+    uint8_t last = LIS2DW_CTRL_COUNT - 1;
+
+    _lis2dw_ctrl_deferred = false;
+    if (!_lis2dw_ctrl_dirty) return;
+
+    // one write from the first changed register to the last; anything unchanged in between gets its shadowed value.
+    while (!(_lis2dw_ctrl_dirty & (1 << first))) first++;
+    while (!(_lis2dw_ctrl_dirty & (1 << last))) last--;
+    buf[0] = (LIS2DW_REG_CTRL1 + first) | 0x80; // set high bit for consecutive writes
+    memcpy(buf + 1, _lis2dw_ctrl + first, last - first + 1);
+    watch_i2c_send(LIS2DW_ADDRESS, buf, last - first + 2);
+    _lis2dw_ctrl_dirty = 0;
+}
+
 uint8_t lis2dw_get_device_id(void) {
     return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WHO_AM_I);
 }
@@ -92,49 +148,49 @@ lis2dw_reading_t lis2dw_get_raw_reading(void) {
 }
 
 void lis2dw_set_range(lis2dw_range_t range) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & ~(LIS2DW_RANGE_16_G << 4);
+    uint8_t val = _lis2dw_read_ctrl(LIS2DW_REG_CTRL6) & ~(LIS2DW_RANGE_16_G << 4);
     uint8_t bits = range << 4;
 
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6, val | bits);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL6, val | bits);
 }
 
 lis2dw_range_t lis2dw_get_range(void) {
-    uint8_t retval = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & (LIS2DW_RANGE_16_G << 4);
+    uint8_t retval = _lis2dw_read_ctrl(LIS2DW_REG_CTRL6) & (LIS2DW_RANGE_16_G << 4);
     retval >>= 4;
     return (lis2dw_range_t)retval;
 }
 
 void lis2dw_set_data_rate(lis2dw_data_rate_t dataRate) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(0b1111 << 4);
+    uint8_t val = _lis2dw_read_ctrl(LIS2DW_REG_CTRL1) & ~(0b1111 << 4);
     uint8_t bits = dataRate << 4;
 
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL1, val | bits);
 }
 
 lis2dw_data_rate_t lis2dw_get_data_rate(void) {
-    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) >> 4;
+    return _lis2dw_read_ctrl(LIS2DW_REG_CTRL1) >> 4;
 }
 
 void lis2dw_set_low_power_mode(lis2dw_low_power_mode_t mode) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(0b11);
+    uint8_t val = _lis2dw_read_ctrl(LIS2DW_REG_CTRL1) & ~(0b11);
     uint8_t bits = mode & 0b11;
 
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL1, val | bits);
 }
 
 lis2dw_low_power_mode_t lis2dw_get_low_power_mode(void) {
-    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & 0b11;
+    return _lis2dw_read_ctrl(LIS2DW_REG_CTRL1) & 0b11;
 }
 
 void lis2dw_set_low_noise_mode(bool on) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(LIS2DW_CTRL6_VAL_LOW_NOISE);
+    uint8_t val = _lis2dw_read_ctrl(LIS2DW_REG_CTRL6) & ~(LIS2DW_CTRL6_VAL_LOW_NOISE);
     uint8_t bits = on ? LIS2DW_CTRL6_VAL_LOW_NOISE : 0;
 
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL6, val | bits);
 }
 
 bool lis2dw_get_low_noise_mode(void) {
-    return (watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & LIS2DW_CTRL6_VAL_LOW_NOISE) != 0;
+    return (_lis2dw_read_ctrl(LIS2DW_REG_CTRL6) & LIS2DW_CTRL6_VAL_LOW_NOISE) != 0;
 }
 
 inline void lis2dw_disable_fifo(void) {
@@ -148,13 +204,16 @@ inline void lis2dw_enable_fifo(void) {
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data) {
     uint8_t temp = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE);
     bool overrun = !!(temp & LIS2DW_FIFO_SAMPLE_OVERRUN);
-    uint8_t buffer[6];
+    uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80; // set high bit for consecutive reads
 
     fifo_data->count = temp & LIS2DW_FIFO_SAMPLE_COUNT;
+    if (fifo_data->count > 32) fifo_data->count = 32;
 
-    for(int i = 0; i < fifo_data->count; i++) {
-        watch_i2c_receive(LIS2DW_ADDRESS, (uint8_t *)&buffer, 6);
-        fifo_data->readings[i] = lis2dw_get_raw_reading();
+    // with the FIFO on, reading past OUT_Z_H wraps back to OUT_X_L and pops the next sample, so one burst gets them
+    // all. the output registers are little-endian, like us, so they can go straight into the readings.
+    if (fifo_data->count) {
+        watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
+        watch_i2c_receive(LIS2DW_ADDRESS, (uint8_t *)fifo_data->readings, fifo_data->count * sizeof(lis2dw_reading_t));
     }
 
     return overrun;
@@ -164,3 +223,191 @@ void lis2dw_clear_fifo(void) {
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_OFF);
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
 }
+
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode, uint8_t threshold) {
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, (mode << 5) | (threshold & LIS2DW_FIFO_CTRL_FTH));
+}
+
+void lis2dw_configure_int1(uint8_t sources) {
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL4, sources);
+}
+
+// INT1 is one line shared by the FIFO threshold and the embedded events, so one interrupt handler serves both.
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_int1_pin;
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_int1_fifo_sources;
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_int1_event_sources;
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_int1_event_mask;
+
+static WATCH_INSTANCE_LOCAL lis2dw_fifo_t *_lis2dw_fifo_buffer = NULL;
+static WATCH_INSTANCE_LOCAL lis2dw_fifo_cb_t _lis2dw_fifo_callback;
+static WATCH_INSTANCE_LOCAL uint8_t _lis2dw_fifo_status;
+static WATCH_INSTANCE_LOCAL volatile bool _lis2dw_fifo_draining;
+
+static WATCH_INSTANCE_LOCAL lis2dw_event_cb_t _lis2dw_event_callback = NULL;
+static WATCH_INSTANCE_LOCAL lis2dw_event_sources_t _lis2dw_event_sources;
+static WATCH_INSTANCE_LOCAL volatile bool _lis2dw_event_reading;
+
+static void _lis2dw_int1_interrupt(void);
+
+static uint8_t _lis2dw_int1_sources(void) {
+    return _lis2dw_int1_fifo_sources | (_lis2dw_int1_event_sources & ~_lis2dw_int1_event_mask);
+}
+
+static void _lis2dw_route_int1(void) {
+    lis2dw_configure_int1(_lis2dw_int1_sources());
+}
+
+// events stay latched until they're read, and a FIFO drain may have been busy when one came in. either way, the line
+// is still high and there won't be another edge, so once a transfer finishes, look again.
+static void _lis2dw_int1_check_level(void) {
+    if (!_lis2dw_fifo_draining && !_lis2dw_event_reading && watch_get_pin_level(_lis2dw_int1_pin)) _lis2dw_int1_interrupt();
+}
+
+static void _lis2dw_fifo_samples_read(int32_t status, void *context) {
+    (void) context;
+    _lis2dw_fifo_draining = false;
+    if (_lis2dw_fifo_buffer == NULL || status != 0) return;
+    _lis2dw_fifo_callback(_lis2dw_fifo_buffer, !!(_lis2dw_fifo_status & LIS2DW_FIFO_SAMPLE_OVERRUN));
+    _lis2dw_int1_check_level();
+}
+
+static void _lis2dw_fifo_status_read(int32_t status, void *context) {
+    (void) context;
+    lis2dw_fifo_t *fifo = _lis2dw_fifo_buffer;
+    if (fifo == NULL || status != 0 || (_lis2dw_fifo_status & LIS2DW_FIFO_SAMPLE_COUNT) == 0) {
+        _lis2dw_fifo_draining = false;
+        return;
+    }
+
+    fifo->count = _lis2dw_fifo_status & LIS2DW_FIFO_SAMPLE_COUNT;
+    if (fifo->count > 32) fifo->count = 32;
+    // same burst as lis2dw_read_fifo, but we're in interrupt context, so it goes through the queue.
+    if (!watch_i2c_read_async(LIS2DW_ADDRESS, LIS2DW_REG_OUT_X_L | 0x80, (uint8_t *)fifo->readings,
+                              fifo->count * sizeof(lis2dw_reading_t), _lis2dw_fifo_samples_read, NULL)) {
+        _lis2dw_fifo_draining = false;
+    }
+}
+
+static void _lis2dw_events_read(int32_t status, void *context) {
+    (void) context;
+    _lis2dw_event_reading = false;
+    if (_lis2dw_event_callback == NULL || status != 0) return;
+    // the FIFO threshold shares the line, so only pass it on if one of our events is actually there.
+    if (_lis2dw_event_sources.all_int_src) _lis2dw_event_callback(&_lis2dw_event_sources);
+    _lis2dw_int1_check_level();
+}
+
+static void _lis2dw_int1_interrupt(void) {
+    // INT1 stays high until the level drops below the threshold, so a drain in progress will take care of it.
+    if (_lis2dw_fifo_buffer != NULL && !_lis2dw_fifo_draining) {
+        _lis2dw_fifo_draining = watch_i2c_read_async(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE, &_lis2dw_fifo_status, 1,
+                                                     _lis2dw_fifo_status_read, NULL);
+    }
+    // the four source registers are consecutive, and reading ALL_INT_SRC at the end clears every latched event.
+    if (_lis2dw_event_callback != NULL && !_lis2dw_event_reading) {
+        _lis2dw_event_reading = watch_i2c_read_async(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_SRC | 0x80, (uint8_t *)&_lis2dw_event_sources,
+                                                     sizeof(lis2dw_event_sources_t), _lis2dw_events_read, NULL);
+    }
+}
+
+bool lis2dw_start_fifo_stream(uint8_t int1_pin, uint8_t threshold, lis2dw_fifo_t *buffer, lis2dw_fifo_cb_t callback) {
+    if (buffer == NULL || callback == NULL || threshold == 0 || threshold > LIS2DW_FIFO_CTRL_FTH) return false;
+
+    _lis2dw_fifo_buffer = buffer;
+    _lis2dw_fifo_callback = callback;
+    _lis2dw_fifo_draining = false;
+
+    // passing through bypass empties the FIFO, so the first batch starts from nothing and INT1 starts out low.
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF, 0);
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS, threshold);
+    _lis2dw_int1_fifo_sources = LIS2DW_CTRL4_INT1_FTH;
+    _lis2dw_route_int1();
+    _lis2dw_int1_pin = int1_pin;
+    watch_register_interrupt_callback(int1_pin, _lis2dw_int1_interrupt, INTERRUPT_TRIGGER_RISING);
+
+    return true;
+}
+
+void lis2dw_stop_fifo_stream(void) {
+    if (_lis2dw_fifo_buffer == NULL) return;
+
+    // clearing the buffer first means a drain that's in flight won't call back.
+    _lis2dw_fifo_buffer = NULL;
+    _lis2dw_int1_fifo_sources = 0;
+    _lis2dw_route_int1();
+    lis2dw_disable_fifo();
+}
+
+void lis2dw_configure_6d(uint8_t threshold) {
+    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_TAP_THS_X) & ~LIS2DW_TAP_THS_X_VAL_6D_THS;
+
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_TAP_THS_X, val | (threshold & LIS2DW_TAP_THS_X_VAL_6D_THS));
+}
+
+void lis2dw_configure_tap(uint8_t axes, uint8_t threshold, uint8_t shock, uint8_t quiet, uint8_t latency, bool double_tap) {
+    uint8_t buf[5];
+    uint8_t wake_up_ths;
+
+    threshold &= LIS2DW_TAP_THS_VAL_THS;
+    // TAP_THS_X shares its register with the 6D settings, which have to survive; the rest is ours, so it goes in one burst.
+    buf[0] = LIS2DW_REG_TAP_THS_X | 0x80;
+    buf[1] = (watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_TAP_THS_X) & ~LIS2DW_TAP_THS_VAL_THS) | threshold;
+    buf[2] = threshold;
+    buf[3] = (axes & (LIS2DW_TAP_THS_Z_VAL_X_EN | LIS2DW_TAP_THS_Z_VAL_Y_EN | LIS2DW_TAP_THS_Z_VAL_Z_EN)) | threshold;
+    buf[4] = ((latency << 4) & LIS2DW_INT1_DUR_VAL_LATENCY) | ((quiet << 2) & LIS2DW_INT1_DUR_VAL_QUIET) | (shock & LIS2DW_INT1_DUR_VAL_SHOCK);
+    watch_i2c_send(LIS2DW_ADDRESS, buf, sizeof(buf));
+
+    wake_up_ths = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_THS) & ~LIS2DW_WAKE_UP_THS_VAL_SINGLE_DOUBLE_TAP;
+    if (double_tap) wake_up_ths |= LIS2DW_WAKE_UP_THS_VAL_SINGLE_DOUBLE_TAP;
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_THS, wake_up_ths);
+}
+
+void lis2dw_configure_wake_up(uint8_t threshold, uint8_t duration) {
+    uint8_t wake_up_ths = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_THS) & ~LIS2DW_WAKE_UP_THS_VAL_WK_THS;
+    uint8_t wake_up_dur = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_DUR) & ~LIS2DW_WAKE_UP_DUR_VAL_WAKE_DUR;
+
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_THS, wake_up_ths | (threshold & LIS2DW_WAKE_UP_THS_VAL_WK_THS));
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_DUR, wake_up_dur | ((duration << 5) & LIS2DW_WAKE_UP_DUR_VAL_WAKE_DUR));
+}
+
+bool lis2dw_enable_events(uint8_t int1_pin, uint8_t sources, lis2dw_event_cb_t callback) {
+    if (callback == NULL || (sources & (LIS2DW_CTRL4_INT1_FTH | LIS2DW_CTRL4_INT1_DRDY))) return false;
+
+    _lis2dw_event_callback = callback;
+    _lis2dw_event_reading = false;
+
+    // the embedded functions only run with interrupts enabled in CTRL7, and the 6D position is less jumpy filtered.
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL7, watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL7) |
+                                                       LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE | LIS2DW_CTRL7_VAL_LPASS_ON6D);
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL3, _lis2dw_read_ctrl(LIS2DW_REG_CTRL3) | LIS2DW_CTRL3_VAL_LIR);
+    _lis2dw_int1_event_sources = sources;
+    _lis2dw_route_int1();
+    _lis2dw_int1_pin = int1_pin;
+    watch_register_interrupt_callback(int1_pin, _lis2dw_int1_interrupt, INTERRUPT_TRIGGER_RISING);
+    // something may already be latched from before, holding the line high; read it now, or we'd never get an edge.
+    _lis2dw_int1_check_level();
+
+    return true;
+}
+
+void lis2dw_mask_events(uint8_t sources) {
+    uint8_t val;
+
+    _lis2dw_int1_event_mask = sources;
+    val = _lis2dw_int1_sources();
+    // this is for event callbacks, so it can't wait on the bus; the cache is updated now and the write is queued.
+    if (_lis2dw_ctrl_valid) {
+        if (_lis2dw_ctrl[LIS2DW_REG_CTRL4 - LIS2DW_REG_CTRL1] == val) return;
+        _lis2dw_ctrl[LIS2DW_REG_CTRL4 - LIS2DW_REG_CTRL1] = val;
+    }
+    watch_i2c_write8_async(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4, val, NULL, NULL);
+}
+
+void lis2dw_disable_events(void) {
+    if (_lis2dw_event_callback == NULL) return;
+
+    _lis2dw_event_callback = NULL;
+    _lis2dw_int1_event_sources = 0;
+    _lis2dw_route_int1();
+    _lis2dw_write_ctrl(LIS2DW_REG_CTRL3, _lis2dw_read_ctrl(LIS2DW_REG_CTRL3) & ~LIS2DW_CTRL3_VAL_LIR);
+}
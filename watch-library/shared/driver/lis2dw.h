@@ -45,6 +45,20 @@ typedef struct {
     lis2dw_reading_t readings[32];
 } lis2dw_fifo_t;
 
+/// Called with each batch of samples drained from the FIFO; overrun is true if samples were lost before this batch.
+typedef void (*lis2dw_fifo_cb_t)(const lis2dw_fifo_t *fifo, bool overrun);
+
+/// The event source registers, WAKE_UP_SRC through ALL_INT_SRC, as read in one burst after an event on INT1.
+typedef struct {
+    uint8_t wake_up_src;
+    uint8_t tap_src;
+    uint8_t sixd_src;
+    uint8_t all_int_src;
+} lis2dw_event_sources_t;
+
+/// Called from interrupt context with the source registers each time INT1 signals one of the enabled events.
+typedef void (*lis2dw_event_cb_t)(const lis2dw_event_sources_t *sources);
+
 typedef enum {
   LIS2DW_DATA_RATE_POWERDOWN = 0,
   LIS2DW_DATA_RATE_LOWEST = 0b0001, // 12.5 Hz in high performance mode, 1.6 Hz in low power
@@ -203,11 +217,32 @@ typedef enum {
 #define LIS2DW_FIFO_SAMPLE_COUNT (0b00111111)
 
 #define LIS2DW_REG_TAP_THS_X 0x30
+#define LIS2DW_TAP_THS_X_VAL_4D_EN     0b10000000
+#define LIS2DW_TAP_THS_X_VAL_6D_THS_80 0b00000000   ///< 6D changes position once tilted 80° from the last one.
+#define LIS2DW_TAP_THS_X_VAL_6D_THS_70 0b00100000
+#define LIS2DW_TAP_THS_X_VAL_6D_THS_60 0b01000000
+#define LIS2DW_TAP_THS_X_VAL_6D_THS_50 0b01100000
+#define LIS2DW_TAP_THS_X_VAL_6D_THS    0b01100000
+#define LIS2DW_TAP_THS_VAL_THS         0b00011111   ///< Tap threshold on each axis, 1 LSB = 1/32 of full scale.
 #define LIS2DW_REG_TAP_THS_Y 0x31
+#define LIS2DW_TAP_THS_Y_VAL_PRIOR     0b11100000
 #define LIS2DW_REG_TAP_THS_Z 0x32
+#define LIS2DW_TAP_THS_Z_VAL_X_EN      0b10000000
+#define LIS2DW_TAP_THS_Z_VAL_Y_EN      0b01000000
+#define LIS2DW_TAP_THS_Z_VAL_Z_EN      0b00100000
 #define LIS2DW_REG_INT1_DUR 0x33
+#define LIS2DW_INT1_DUR_VAL_LATENCY    0b11110000   ///< Longest gap between the taps of a double tap, 1 LSB = 32 / ODR.
+#define LIS2DW_INT1_DUR_VAL_QUIET      0b00001100   ///< Quiet time after a tap, 1 LSB = 4 / ODR.
+#define LIS2DW_INT1_DUR_VAL_SHOCK      0b00000011   ///< Longest a tap can stay over threshold, 1 LSB = 8 / ODR.
 #define LIS2DW_REG_WAKE_UP_THS 0x34
+#define LIS2DW_WAKE_UP_THS_VAL_SINGLE_DOUBLE_TAP 0b10000000
+#define LIS2DW_WAKE_UP_THS_VAL_SLEEP_ON          0b01000000
+#define LIS2DW_WAKE_UP_THS_VAL_WK_THS            0b00111111   ///< Wake-up threshold, 1 LSB = 1/64 of full scale.
 #define LIS2DW_REG_WAKE_UP_DUR 0x35
+#define LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5    0b10000000
+#define LIS2DW_WAKE_UP_DUR_VAL_WAKE_DUR   0b01100000   ///< Samples over the threshold before a wake-up, 1 LSB = 1 / ODR.
+#define LIS2DW_WAKE_UP_DUR_VAL_STATIONARY 0b00010000
+#define LIS2DW_WAKE_UP_DUR_VAL_SLEEP_DUR  0b00001111
 #define LIS2DW_REG_FREE_FALL 0x36
 #define LIS2DW_REG_STATUS_DUP 0x37
 
@@ -261,6 +296,12 @@ typedef enum {
 
 bool lis2dw_begin(void);
 
+// The driver keeps a copy of CTRL1-CTRL6, so the getters below cost no bus traffic and each setter is a single write.
+// Between these two calls, setters only update that copy; apply then writes every changed register in one burst.
+void lis2dw_begin_configuration(void);
+
+void lis2dw_apply_configuration(void);
+
 uint8_t lis2dw_get_device_id(void);
 
 bool lis2dw_have_new_data(void);
@@ -293,4 +334,40 @@ bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data);
 
 void lis2dw_clear_fifo(void);
 
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode, uint8_t threshold);
+
+void lis2dw_configure_int1(uint8_t sources);
+
+// Puts the FIFO in continuous mode and routes its threshold to INT1. Each time threshold (1-31) samples pile up, the
+// FIFO is drained into buffer with one burst over asynchronous I2C, and callback is called with it from interrupt
+// context. int1_pin is the watch pin that INT1 is wired to; configure it as an input first.
+bool lis2dw_start_fifo_stream(uint8_t int1_pin, uint8_t threshold, lis2dw_fifo_t *buffer, lis2dw_fifo_cb_t callback);
+
+// Turns the FIFO and its INT1 signal off again. Once it returns, nothing more is written to the buffer.
+void lis2dw_stop_fifo_stream(void);
+
+// Sets the tilt, one of the LIS2DW_TAP_THS_X_VAL_6D_THS_* values, past which 6D reports a change of position.
+void lis2dw_configure_6d(uint8_t threshold);
+
+// Sets up the tap engine on axes (LIS2DW_TAP_THS_Z_VAL_*_EN) with threshold in 1/32 of full scale (1-31). shock, quiet
+// and latency go into INT1_DUR as they are, so they scale with the data rate; 0 picks the data sheet's default. With
+// double_tap, a second tap inside the latency window is reported as a double tap as well.
+void lis2dw_configure_tap(uint8_t axes, uint8_t threshold, uint8_t shock, uint8_t quiet, uint8_t latency, bool double_tap);
+
+// Sets the wake-up threshold in 1/64 of full scale (1-63), applied to high-passed acceleration, and the number of
+// samples (0-3) it has to be exceeded for. The tap engine's settings in the same registers are left alone.
+void lis2dw_configure_wake_up(uint8_t threshold, uint8_t duration);
+
+// Latches the embedded events in sources (LIS2DW_CTRL4_INT1_6D, _WU, _SINGLE_TAP, _TAP or _FF) and routes them to
+// INT1. Each time INT1 fires, the source registers are read in one burst over asynchronous I2C, which clears the
+// latch, and passed to callback. This can share INT1 with the FIFO stream. Calling it again replaces the sources.
+bool lis2dw_enable_events(uint8_t int1_pin, uint8_t sources, lis2dw_event_cb_t callback);
+
+// Stops routing events to INT1. Once it returns, the callback won't be called again.
+void lis2dw_disable_events(void);
+
+// Holds back the enabled events in sources from INT1 (0 lets them all through again) without forgetting them; it
+// lasts until the next call. The write goes over asynchronous I2C, so it's safe to call from the event callback.
+void lis2dw_mask_events(uint8_t sources);
+
 #endif // LIS2DW_H
@@ -28,7 +28,33 @@
 
 #include "spiflash.h"
 
-#define SPI_FLASH_FAST_READ false
+// DMA transfers top out at 65535 bytes; longer reads keep chip select low and carry on where the last chunk stopped.
+#define SPI_FLASH_READ_CHUNK (32768)
+
+// typical busy times for the W25Q16JV, in microseconds. we sleep that long before the first status read, then check
+// back every eighth of it. a page program is 30 µs to get going and about 1.5 µs a byte after that.
+#define SPI_FLASH_PAGE_PROGRAM_SETUP_US (30)
+#define SPI_FLASH_PAGE_PROGRAM_US (400)
+#define SPI_FLASH_SECTOR_ERASE_US (45000)
+#define SPI_FLASH_BLOCK_32K_ERASE_US (120000)
+#define SPI_FLASH_BLOCK_64K_ERASE_US (150000)
+// after CMD_WAKE, the chip needs tRES1 before it will take another command.
+#define SPI_FLASH_WAKE_US (3)
+
+typedef struct {
+    uint8_t *data;                  // where the next chunk goes
+    uint32_t remaining;
+    uint32_t restore_frequency;     // the bus clock to go back to, or 0 if we didn't change it
+    watch_spi_cb_t callback;
+    void *context;
+} spi_flash_read_state_t;
+
+static WATCH_INSTANCE_LOCAL bool spi_flash_fast_read = false;
+static WATCH_INSTANCE_LOCAL spi_flash_read_state_t spi_flash_read_state;
+static WATCH_INSTANCE_LOCAL bool spi_flash_powered_down = false;
+static WATCH_INSTANCE_LOCAL uint8_t spi_flash_wake_count = 0;
+// set from interrupt context when an async read is done, but its wake and bus clock haven't been given back yet.
+static WATCH_INSTANCE_LOCAL volatile bool spi_flash_read_finished = false;
 
 static void flash_enable(void) {
     watch_set_pin_level(A3, false);
@@ -39,6 +65,7 @@ static void flash_disable(void) {
 }
 
 static bool transfer(uint8_t *command, uint32_t command_length, uint8_t *data_in, uint8_t *data_out, uint32_t data_length) {
+    flash_enable();
     bool status = watch_spi_write(command, command_length);
     if (status) {
         if (data_in != NULL && data_out != NULL) {
@@ -57,16 +84,74 @@ static bool transfer_command(uint8_t command, uint8_t *data_in, uint8_t *data_ou
     return transfer(&command, 1, data_in, data_out, data_length);
 }
 
+// waits by clocking dummy bytes with chip select high: the flash ignores them, and the CPU idles while DMA runs the bus.
+// the bus runs at or below the frequency we asked for, so this is never shorter than asked.
+static void _spi_flash_delay(uint32_t microseconds) {
+    uint32_t remaining = microseconds * (watch_spi_get_frequency() / 1000) / 8000 + 1;
+
+    while (remaining) {
+        uint16_t length = (remaining > 65535) ? 65535 : remaining;
+        if (!watch_spi_transfer_async(NULL, NULL, length, NULL, NULL)) return;
+        watch_spi_wait();
+        remaining -= length;
+    }
+}
+
+static void _spi_flash_sleep(void) {
+    if (!spi_flash_wake_count || --spi_flash_wake_count) return;
+    // a chip that's busy ignores this, but every write and erase here waits for it to finish before it lets go.
+    transfer_command(CMD_POWER_DOWN, NULL, NULL, 0);
+    spi_flash_powered_down = true;
+}
+
+// an async read's interrupt only lets go of chip select; putting the bus clock back is left to thread context, since it
+// waits on the SERCOM. returns true if there was a read to finish, whose wake the caller now has to give back.
+static bool _spi_flash_finish_read(void) {
+    if (!spi_flash_read_finished) return false;
+    spi_flash_read_finished = false;
+    if (spi_flash_read_state.restore_frequency) watch_spi_set_frequency(spi_flash_read_state.restore_frequency);
+    return true;
+}
+
+void spi_flash_wake(void) {
+    watch_spi_wait();
+    // a finished read is still holding the chip awake; take that over rather than putting it to sleep and waking it.
+    if (_spi_flash_finish_read()) return;
+    if (spi_flash_wake_count++ || !spi_flash_powered_down) return;
+    spi_flash_powered_down = false;
+    transfer_command(CMD_WAKE, NULL, NULL, 0);
+    _spi_flash_delay(SPI_FLASH_WAKE_US);
+}
+
+void spi_flash_sleep(void) {
+    if (_spi_flash_finish_read()) _spi_flash_sleep();
+    _spi_flash_sleep();
+}
+
+void spi_flash_wait(void) {
+    watch_spi_wait();
+    if (_spi_flash_finish_read()) _spi_flash_sleep();
+}
+
 bool spi_flash_command(uint8_t command) {
-    return transfer_command(command, NULL, NULL, 0);
+    spi_flash_wake();
+    bool status = transfer_command(command, NULL, NULL, 0);
+    spi_flash_sleep();
+    return status;
 }
 
 bool spi_flash_read_command(uint8_t command, uint8_t *data, uint32_t data_length) {
-    return transfer_command(command, NULL, data, data_length);
+    spi_flash_wake();
+    bool status = transfer_command(command, NULL, data, data_length);
+    spi_flash_sleep();
+    return status;
 }
 
 bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t data_length) {
-    return transfer_command(command, data, NULL, data_length);
+    spi_flash_wake();
+    bool status = transfer_command(command, data, NULL, data_length);
+    spi_flash_sleep();
+    return status;
 }
 
 // Pack the low 24 bits of the address into a uint8_t array.
@@ -76,45 +161,190 @@ static void address_to_bytes(uint32_t address, uint8_t *bytes) {
     bytes[2] = address & 0xff;
 }
 
-bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+static bool _spi_flash_sector_command(uint8_t command, uint32_t address) {
     uint8_t request[4] = {command, 0x00, 0x00, 0x00};
     address_to_bytes(address, request + 1);
     return transfer(request, 4, NULL, NULL, 0);
 }
 
-bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    spi_flash_wake();
+    bool status = _spi_flash_sector_command(command, address);
+    spi_flash_sleep();
+    return status;
+}
+
+// sleeps for the typical time, then keeps checking the WIP bit until the program or erase is done.
+static bool _spi_flash_wait_until_ready(uint32_t typical_us) {
+    uint8_t status;
+
+    _spi_flash_delay(typical_us);
+    while (true) {
+        if (!transfer_command(CMD_READ_STATUS, NULL, &status, 1)) return false;
+        if (!(status & SPI_FLASH_STATUS_WIP)) return true;
+        _spi_flash_delay(typical_us / 8);
+    }
+}
+
+// the blocking calls start a transfer, then wait in IDLE for this to record how it went.
+static void _spi_flash_store_status(int32_t status, void *context) {
+    *(volatile int32_t *)context = status;
+}
+
+static bool _spi_flash_program_page(uint32_t address, uint8_t *data, uint16_t data_length) {
     uint8_t request[4] = {CMD_PAGE_PROGRAM, 0x00, 0x00, 0x00};
+    volatile int32_t status = -1;
+
+    if (!transfer_command(CMD_ENABLE_WRITE, NULL, NULL, 0)) return false;
     // Write the SPI flash write address into the bytes following the command byte.
     address_to_bytes(address, request + 1);
     flash_enable();
-    bool status = watch_spi_write(request, 4);
-    if (status) {
-        status = watch_spi_write(data, data_length);
+    if (watch_spi_write(request, 4) && watch_spi_transfer_async(data, NULL, data_length, _spi_flash_store_status, (void *)&status)) {
+        watch_spi_wait();
     }
     flash_disable();
+    if (status != 0) return false;
+
+    return _spi_flash_wait_until_ready(SPI_FLASH_PAGE_PROGRAM_SETUP_US + (SPI_FLASH_PAGE_PROGRAM_US - SPI_FLASH_PAGE_PROGRAM_SETUP_US) * data_length / SPI_FLASH_PAGE_SIZE);
+}
+
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    bool status = true;
+
+    spi_flash_wake();
+    while (status && data_length) {
+        // a page program that runs past the end of the page wraps around to the start of it.
+        uint16_t length = SPI_FLASH_PAGE_SIZE - (address & (SPI_FLASH_PAGE_SIZE - 1));
+        if (length > data_length) length = data_length;
+
+        status = _spi_flash_program_page(address, data, length);
+        address += length;
+        data += length;
+        data_length -= length;
+    }
+    spi_flash_sleep();
+
     return status;
 }
 
-bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
-    uint8_t request[5] = {CMD_READ_DATA, 0x00, 0x00, 0x00};
+bool spi_flash_erase(uint32_t address, uint32_t length) {
+    bool status = true;
+
+    if ((address | length) & (SPI_FLASH_SECTOR_SIZE - 1)) return false;
+
+    spi_flash_wake();
+    while (status && length) {
+        uint8_t command = CMD_SECTOR_ERASE;
+        uint32_t size = SPI_FLASH_SECTOR_SIZE;
+        uint32_t typical_us = SPI_FLASH_SECTOR_ERASE_US;
+
+        if (!(address & (SPI_FLASH_BLOCK_64K_SIZE - 1)) && length >= SPI_FLASH_BLOCK_64K_SIZE) {
+            command = CMD_BLOCK_ERASE_64K;
+            size = SPI_FLASH_BLOCK_64K_SIZE;
+            typical_us = SPI_FLASH_BLOCK_64K_ERASE_US;
+        } else if (!(address & (SPI_FLASH_BLOCK_32K_SIZE - 1)) && length >= SPI_FLASH_BLOCK_32K_SIZE) {
+            command = CMD_BLOCK_ERASE_32K;
+            size = SPI_FLASH_BLOCK_32K_SIZE;
+            typical_us = SPI_FLASH_BLOCK_32K_ERASE_US;
+        }
+
+        status = transfer_command(CMD_ENABLE_WRITE, NULL, NULL, 0) &&
+                 _spi_flash_sector_command(command, address) &&
+                 _spi_flash_wait_until_ready(typical_us);
+        address += size;
+        length -= size;
+    }
+    spi_flash_sleep();
+
+    return status;
+}
+
+// the async read path below (DMA, and chaining chunks from its interrupt) has so far only run against the flash model
+// in the simulator and host builds, never on a board.
+
+static void _spi_flash_read_done(int32_t status, void *context);
+
+static bool _spi_flash_read_next_chunk(void) {
+    uint16_t length = (spi_flash_read_state.remaining > SPI_FLASH_READ_CHUNK) ? SPI_FLASH_READ_CHUNK : spi_flash_read_state.remaining;
+    uint8_t *data = spi_flash_read_state.data;
+
+    spi_flash_read_state.data += length;
+    spi_flash_read_state.remaining -= length;
+
+    return watch_spi_transfer_async(NULL, data, length, _spi_flash_read_done, NULL);
+}
+
+// called from the DMA interrupt, so it does nothing that blocks; spi_flash_wait and friends do the rest.
+static void _spi_flash_read_finish(int32_t status) {
+    flash_disable();
+    spi_flash_read_finished = true;
+    if (spi_flash_read_state.callback != NULL) spi_flash_read_state.callback(status, spi_flash_read_state.context);
+}
+
+static void _spi_flash_read_done(int32_t status, void *context) {
+    (void) context;
+    // the flash keeps streaming from the next address for as long as chip select stays low.
+    if (status == 0 && spi_flash_read_state.remaining) {
+        if (_spi_flash_read_next_chunk()) return;
+        status = -1;
+    }
+    _spi_flash_read_finish(status);
+}
+
+void spi_flash_set_fast_read(bool fast_read) {
+    spi_flash_fast_read = fast_read;
+}
+
+bool spi_flash_read_data_async(uint32_t address, uint8_t *data, uint32_t data_length, watch_spi_cb_t callback, void *context) {
+    uint8_t request[5] = {CMD_READ_DATA, 0x00, 0x00, 0x00, 0x00};
     uint8_t command_length = 4;
-    if (SPI_FLASH_FAST_READ) {
+
+    if (data_length == 0 || watch_spi_is_busy()) return false;
+    if (spi_flash_fast_read) {
         request[0] = CMD_FAST_READ_DATA;
         command_length = 5;
     }
     // Write the SPI flash read address into the bytes following the command byte.
     address_to_bytes(address, request + 1);
+    spi_flash_wake();
+
+    spi_flash_read_state.data = data;
+    spi_flash_read_state.remaining = data_length;
+    spi_flash_read_state.restore_frequency = 0;
+    spi_flash_read_state.callback = callback;
+    spi_flash_read_state.context = context;
+    // for a handful of bytes the command dominates, but a long read is all clock.
+    if (data_length >= SPI_FLASH_BULK_READ_LENGTH && watch_spi_get_frequency() < SPI_FLASH_BULK_FREQUENCY) {
+        spi_flash_read_state.restore_frequency = watch_spi_get_frequency();
+        watch_spi_set_frequency(SPI_FLASH_BULK_FREQUENCY);
+    }
+
     flash_enable();
-    bool status = watch_spi_write(request, command_length);
-    if (status) {
-        status = watch_spi_read(data, data_length);
+    if (!watch_spi_write(request, command_length) || !_spi_flash_read_next_chunk()) {
+        spi_flash_read_state.callback = NULL;
+        _spi_flash_read_finish(-1);
+        spi_flash_wait();
+        return false;
     }
-    flash_disable();
-    return status;
+
+    return true;
+}
+
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    volatile int32_t status = -1;
+
+    if (!spi_flash_read_data_async(address, data, data_length, _spi_flash_store_status, (void *)&status)) return false;
+    spi_flash_wait();
+
+    return status == 0;
 }
 
 void spi_flash_init(void) {
 	gpio_set_pin_level(A3, true);
 	gpio_set_pin_direction(A3, GPIO_DIRECTION_OUT);
     watch_enable_spi();
+    // the chip keeps its power state across a reset of ours, so we don't know it; a wake is harmless if it's up.
+    spi_flash_powered_down = true;
+    spi_flash_wake();
+    spi_flash_sleep();
 }
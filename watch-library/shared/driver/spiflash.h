@@ -46,11 +46,52 @@
 #define CMD_ENABLE_RESET 0x66
 #define CMD_RESET 0x99
 #define CMD_WAKE 0xab
+#define CMD_POWER_DOWN 0xb9
+#define CMD_BLOCK_ERASE_32K 0x52
+#define CMD_BLOCK_ERASE_64K 0xd8
+#define CMD_CHIP_ERASE 0xc7
+
+#define SPI_FLASH_STATUS_WIP (1 << 0)
+#define SPI_FLASH_STATUS_WEL (1 << 1)
+
+#define SPI_FLASH_PAGE_SIZE (256)
+#define SPI_FLASH_SECTOR_SIZE (4096)
+#define SPI_FLASH_BLOCK_32K_SIZE (32768)
+#define SPI_FLASH_BLOCK_64K_SIZE (65536)
 
 bool spi_flash_command(uint8_t command);
 bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length);
 bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length);
 bool spi_flash_sector_command(uint8_t command, uint32_t address);
-bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length);
 bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length);
 void spi_flash_init(void);
+
+// Programs any length at any address: the data is split at page boundaries, and each page gets its own WRITE_ENABLE
+// and waits out the program time before the next one starts. Bits can only be cleared; erase the range first.
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length);
+
+// Erases a range that starts and ends on a 4K sector boundary, using the biggest aligned blocks (64K, 32K or 4K) that
+// fit. Returns false without erasing anything if the range isn't aligned. Returns once the last block is done.
+bool spi_flash_erase(uint32_t address, uint32_t length);
+
+// Between calls, the chip sits in deep power-down, where it draws well under a microamp rather than several; every
+// call here wakes it on the way in and puts it back on the way out. For a burst of small operations, wrap them in
+// spi_flash_wake and spi_flash_sleep to keep it up until the last one. These nest.
+void spi_flash_wake(void);
+void spi_flash_sleep(void);
+
+// Reads use READ (0x03) by default. FAST_READ (0x0B) costs a dummy byte after the address, but is good up to the
+// chip's full clock rate rather than about half of it; turn it on if you've raised the bus past what READ can do.
+void spi_flash_set_fast_read(bool fast_read);
+
+// Starts a read of any length and returns right away; the bytes move by DMA while the CPU sleeps, and callback is
+// called from interrupt context once they're all in (or the transfer failed). Reads of SPI_FLASH_BULK_READ_LENGTH or
+// more run the bus at up to SPI_FLASH_BULK_FREQUENCY. Putting the clock back and the chip to sleep both block, so
+// they wait for spi_flash_wait, or for whichever call here comes next. spi_flash_read_data is the same thing, with
+// spi_flash_wait after it.
+#define SPI_FLASH_BULK_READ_LENGTH (64)
+#define SPI_FLASH_BULK_FREQUENCY (8000000)
+bool spi_flash_read_data_async(uint32_t address, uint8_t *data, uint32_t data_length, watch_spi_cb_t callback, void *context);
+
+// Waits in IDLE for an async read to finish, then puts the bus clock back and the chip to sleep.
+void spi_flash_wait(void);
@@ -46,7 +46,41 @@ void thermistor_driver_disable(void) {
     watch_disable_digital_output(THERMISTOR_ENABLE_PIN);
 }
 
-float thermistor_driver_get_temperature(void) {
+// ADC code to temperature in hundredths of a degree Celsius, sampled every 1024 codes from 1024 to 64512. Generated
+// by utils/thermistor_lut.py for the parameters in thermistor_driver.h; if you change those, regenerate it.
+// The codes at either end are an open or shorted divider rather than a temperature, so the table stops short of them,
+// and readings beyond its first and last entries are clamped to those (about -55 °C and 201 °C).
+#define THERMISTOR_TABLE_SHIFT (10)
+static const int16_t thermistor_table[] = {
+    -5479, -4430, -3757, -3247, -2829, -2470, -2152, -1866,
+    -1603, -1359, -1129, -912, -705, -507, -316, -131,
+    49, 224, 396, 564, 731, 895, 1057, 1218,
+    1379, 1538, 1698, 1858, 2018, 2179, 2341, 2505,
+    2671, 2838, 3009, 3182, 3359, 3539, 3724, 3914,
+    4110, 4312, 4521, 4738, 4964, 5201, 5450, 5712,
+    5990, 6286, 6604, 6947, 7322, 7733, 8191, 8708,
+    9303, 10002, 10852, 11929, 13392, 15628, 20098,
+};
+#define THERMISTOR_TABLE_LENGTH (sizeof(thermistor_table) / sizeof(thermistor_table[0]))
+
+_Static_assert(THERMISTOR_HIGH_SIDE && (int)THERMISTOR_B_COEFFICIENT == 3380 && (int)THERMISTOR_NOMINAL_TEMPERATURE == 25 &&
+               (int)THERMISTOR_NOMINAL_RESISTANCE == 10000 && (int)THERMISTOR_SERIES_RESISTANCE == 10000,
+               "thermistor_table was generated for different parameters; rerun utils/thermistor_lut.py");
+
+int16_t thermistor_driver_convert(uint16_t value) {
+    // entry i is for code (i + 1) << THERMISTOR_TABLE_SHIFT.
+    if (value < (1 << THERMISTOR_TABLE_SHIFT)) return thermistor_table[0];
+    if (value >= (THERMISTOR_TABLE_LENGTH << THERMISTOR_TABLE_SHIFT)) return thermistor_table[THERMISTOR_TABLE_LENGTH - 1];
+
+    uint16_t index = (value >> THERMISTOR_TABLE_SHIFT) - 1;
+    int32_t fraction = value & ((1 << THERMISTOR_TABLE_SHIFT) - 1);
+    int32_t lower = thermistor_table[index];
+    int32_t upper = thermistor_table[index + 1];
+
+    return lower + (((upper - lower) * fraction) >> THERMISTOR_TABLE_SHIFT);
+}
+
+static uint16_t _thermistor_driver_read(void) {
     // set the enable pin to the level that powers the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, THERMISTOR_ENABLE_VALUE);
     // get the sense pin level
@@ -54,5 +88,13 @@ float thermistor_driver_get_temperature(void) {
     // and then set the enable pin to the opposite value to power down the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
 
-    return watch_utility_thermistor_temperature(value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT, THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE, THERMISTOR_SERIES_RESISTANCE);
+    return value;
+}
+
+int16_t thermistor_driver_get_temperature_centi(void) {
+    return thermistor_driver_convert(_thermistor_driver_read());
+}
+
+float thermistor_driver_get_temperature(void) {
+    return thermistor_driver_get_temperature_centi() / 100.0;
 }
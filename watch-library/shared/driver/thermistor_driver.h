@@ -25,6 +25,9 @@
 #ifndef THERMISTOR_DRIVER_H_
 #define THERMISTOR_DRIVER_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+
 // TODO: Do these belong in movement_config.h? In settings we can set on the watch? In an EEPROM configuration area?
 // Think on this. [joey 11/22]
 #define THERMISTOR_SENSE_PIN (A2)
@@ -38,6 +41,14 @@
 
 void thermistor_driver_enable(void);
 void thermistor_driver_disable(void);
+/** @brief Takes a reading and returns the temperature in hundredths of a degree Celsius.
+  * @details Uses a lookup table with linear interpolation instead of watch_utility_thermistor_temperature,
+  *          so there is no floating point or libm on the path; within 0.05 °C of it from -20 to 70 °C.
+  */
+int16_t thermistor_driver_get_temperature_centi(void);
+/// @brief Converts a raw reading from the sense pin (0-65535) to hundredths of a degree Celsius.
+int16_t thermistor_driver_convert(uint16_t value);
+/// @brief Takes a reading and returns the temperature in degrees Celsius.
 float thermistor_driver_get_temperature(void);
 
 #endif // THERMISTOR_DRIVER_H_
@@ -30,6 +30,22 @@
 #include "driver_init.h"
 #include "pins.h"
 
+// The host build runs many watches in one process, one per thread, and defines this as __thread. Any state that
+// belongs to a single watch (rather than to the process) should be declared WATCH_INSTANCE_LOCAL.
+#ifndef WATCH_INSTANCE_LOCAL
+#define WATCH_INSTANCE_LOCAL
+#endif
+
+// Functions on the hot path of every wake (the RTC interrupt, the tick callbacks, the display) can be marked
+// WATCH_RAMFUNC. Building with `make RAMFUNC=1` places them in SRAM, so a short wake needn't wait on the flash;
+// the startup code copies them there along with .data. Elsewhere it does nothing. The HAL's segment calls and the
+// character tables they use stay in flash, so this only moves part of the path; see make.mk for how to measure it.
+#ifdef WATCH_RUN_FROM_RAM
+#define WATCH_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#else
+#define WATCH_RAMFUNC
+#endif
+
 /** @mainpage Sensor Watch Documentation
  *  @brief This documentation covers most of the functions you will use to interact with the Sensor Watch
            hardware. It is divided into the following sections:
@@ -65,6 +81,7 @@
 #include "watch_spi.h"
 #include "watch_uart.h"
 #include "watch_deepsleep.h"
+#include "watch_profile.h"
 
 #include "watch_private.h"
 
@@ -75,4 +92,47 @@
   */
 bool watch_is_buzzer_or_led_enabled(void);
 
+/// @brief Performance levels for watch_request_performance.
+typedef enum {
+    WATCH_PERFORMANCE_NORMAL = 0,   ///< 4 MHz main clock at performance level PL0 (8 MHz at PL2 when plugged into USB).
+    WATCH_PERFORMANCE_HIGH,         ///< 16 MHz main clock at performance level PL2, for bursts of heavy computation.
+} watch_performance_t;
+
+/** @brief Switches the main clock and the core voltage to suit the work at hand.
+  * @details Computing planetary positions in soft float can lock up the UI for seconds at 4 MHz. Requesting
+  *          WATCH_PERFORMANCE_HIGH before such a computation and WATCH_PERFORMANCE_NORMAL after it lets the
+  *          watch finish four times faster and go back to sleep sooner; at 16 MHz the chip draws more current,
+  *          but for a quarter of the time, and its fixed overheads are paid only once.
+  *          The ADC prescaler, UART baud rate, SPI bus clock, LED and buzzer PWM and the delay functions are all
+  *          adjusted to match the new clock. Only I2C keeps its divider, so its bus clock scales with the main
+  *          clock while in WATCH_PERFORMANCE_HIGH (the I2C bus runs at 400 kHz).
+  * @param level The performance level to switch to.
+  * @note Return to WATCH_PERFORMANCE_NORMAL before your app goes back to sleep.
+  */
+void watch_request_performance(watch_performance_t level);
+
+/// @brief Returns the performance level most recently requested with watch_request_performance.
+watch_performance_t watch_get_performance(void);
+
+/** @brief Reconfigures the brownout detector, which watches VCC and raises an interrupt when it drops too low.
+  * @details The detector samples VCC periodically in both ACTIVE and STANDBY. When it trips, the interrupt handler
+  *          turns off the regulator's low power efficiency mode (which only works above 2.5V), disarms the
+  *          detector and sets a flag you can pick up with watch_get_brownout_detected. Call this again to re-arm it.
+  *          At boot it's armed at 2.6V and samples once a second.
+  * @param millivolts The threshold, from 1479 to 3587 mV in 34 mV steps. Pass 0 to disarm the detector.
+  * @param sample_interval How often to sample, in seconds. Rounded down to a power of two from 1 to 64; longer
+  *                        intervals draw a little less current.
+  */
+void watch_configure_brownout_detector(uint16_t millivolts, uint8_t sample_interval);
+
+/// @brief Returns true if the brownout detector has tripped since the last call, and clears the flag.
+bool watch_get_brownout_detected(void);
+
+/** @brief Enables or disables the voltage regulator's low power efficiency mode.
+  * @details In STANDBY the low power regulator is more efficient in this mode, but it needs VCC above 2.5V to
+  *          work. _watch_init enables it if the battery is above 2.7V, and the brownout handler disables it as the
+  *          battery drains; call this to enable it again if the voltage has recovered.
+  */
+void watch_set_regulator_low_power_efficiency(bool enabled);
+
 #endif /* WATCH_H_ */
\ No newline at end of file
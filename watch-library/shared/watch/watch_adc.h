@@ -153,5 +153,81 @@ void watch_disable_analog_input(const uint8_t pin);
   **/
 void watch_disable_adc(void);
 
+/** @brief A callback for watch_adc_start_scan.
+  * @param results The buffer you passed to watch_adc_start_scan, with one reading per pin in your list, or NULL if
+  *                the scan failed (which takes a DMA bus error, and shouldn't happen).
+  * @param count The number of pins in the list, or 0 if the scan failed.
+  */
+typedef void (*watch_adc_scan_cb_t)(const uint16_t *results, uint8_t count);
+
+/** @brief Reads several analog pins in one go, and calls you back when they've all been read.
+  * @details Rather than switching the ADC's input and spinning on each conversion the way
+  *          watch_get_analog_pin_level does, this hands the whole list to the ADC's sequencer and lets the
+  *          DMA controller collect the results, so your app can return from its loop and let the watch sleep
+  *          until the callback arrives. The sequencer always converts its inputs in the same fixed order;
+  *          the results are put back in the order of your list before you see them.
+  *
+  *          Call watch_enable_adc and watch_enable_analog_input for each pin first; the number of samples,
+  *          sampling length and reference voltage you set up apply to every pin. Don't call the other ADC
+  *          functions until the callback has been called.
+  * @param pins A list of pins from A0-A4. A pin may appear more than once.
+  * @param count The number of pins in the list, up to 8.
+  * @param results Where to store the readings, one per pin. It must stay valid until the callback.
+  * @param callback The function to call once every pin has been read. It runs in interrupt context.
+  * @return true if the scan was started; false if a pin was invalid, or the ADC is busy sampling or scanning.
+  * @note VCC can't be part of a scan: it has to be measured against the internal reference, and the
+  *       sequencer can't change references between inputs. Use watch_get_vcc_voltage for that.
+  */
+bool watch_adc_start_scan(const uint8_t *pins, uint8_t count, uint16_t *results, watch_adc_scan_cb_t callback);
+
+/** @brief A callback for watch_adc_start_sampling.
+  * @param samples The buffer you passed to watch_adc_start_sampling, now full of samples.
+  * @param count The number of samples in the buffer.
+  */
+typedef void (*watch_adc_sampling_cb_t)(const uint16_t *samples, uint16_t count);
+
+/** @brief Samples an analog pin on a schedule, without waking the CPU for each sample.
+  * @details The RTC's periodic event is routed through the event system to start a conversion, and the DMA
+  *          controller stores each result in your buffer, all while the CPU stays in STANDBY. Your callback
+  *          is called from an interrupt once the buffer is full, and then sampling starts over at the top of
+  *          the buffer. So a logger that wants a reading a second, sixty at a time, wakes once a minute
+  *          instead of sixty times.
+  *
+  *          Call watch_enable_adc and watch_enable_analog_input first. The number of samples, sampling length
+  *          and reference voltage you set up with the other functions in this section apply to each sample.
+  *          While sampling, don't use the other ADC functions; stop sampling first.
+  * @param pin One of pins A0-A4.
+  * @param frequency How often to take a sample, in Hz. Must be a power of two from 1 to 128.
+  * @param buffer Where to store the samples. It must stay valid until you stop sampling.
+  * @param count The number of samples in a batch.
+  * @param callback The function to call with each full batch. It runs in interrupt context, and the next
+  *                 batch overwrites the buffer, so copy out what you need and return quickly.
+  * @note If a sensor needs power to be read (like the thermistor's voltage divider), it has to stay powered
+  *       for as long as you're sampling.
+  */
+void watch_adc_start_sampling(const uint8_t pin, uint8_t frequency, uint16_t *buffer, uint16_t count, watch_adc_sampling_cb_t callback);
+
+/** @brief Arms a window comparator on the samples taken by watch_adc_start_sampling, so that you can react
+  *        to a threshold being crossed right away rather than at the end of the batch.
+  * @details The callback is called from an interrupt the first time a sample falls outside the window, and
+  *          then the comparator disarms itself; call this function again to re-arm it.
+  * @param lower The lowest value that's inside the window.
+  * @param upper The highest value that's inside the window.
+  * @param callback The function to call when a sample falls outside the window, or NULL to disarm it.
+  */
+void watch_adc_set_sampling_window(uint16_t lower, uint16_t upper, ext_irq_cb_t callback);
+
+/** @brief Stops sampling, and puts the ADC back the way watch_adc_start_sampling found it.
+  * @return The number of samples in the buffer from the batch that was in progress.
+  */
+uint16_t watch_adc_stop_sampling(void);
+
+/** @brief Returns true while watch_adc_start_sampling or watch_adc_start_scan has the ADC.
+  * @details Until then, leave the ADC alone: watch_enable_adc resets it, watch_disable_adc stops its clock, and
+  *          a one-off reading reconfigures its input, any of which would stop the sampling or scan in its tracks
+  *          without calling back.
+  */
+bool watch_adc_is_busy(void);
+
 /// @}
 #endif
@@ -28,9 +28,9 @@
 #include "watch.h"
 
 // These are declared in watch_rtc.c.
-extern ext_irq_cb_t btn_alarm_callback;
-extern ext_irq_cb_t a2_callback;
-extern ext_irq_cb_t a4_callback;
+extern WATCH_INSTANCE_LOCAL ext_irq_cb_t btn_alarm_callback;
+extern WATCH_INSTANCE_LOCAL ext_irq_cb_t a2_callback;
+extern WATCH_INSTANCE_LOCAL ext_irq_cb_t a4_callback;
 
 /** @addtogroup deepsleep Sleep Control
   * @brief This section covers functions related to the various sleep modes available to the watch,
@@ -151,6 +151,50 @@ void watch_enter_deep_sleep_mode(void);
   */
 void watch_enter_backup_mode(void);
 
+/// @brief The sleep levels watch_choose_sleep_level picks between, from shallowest to deepest.
+typedef enum {
+    WATCH_SLEEP_LEVEL_IDLE = 0,     ///< IDLE: the CPU halts, but the main clock and every peripheral keep running.
+    WATCH_SLEEP_LEVEL_STANDBY,      ///< STANDBY: the main clock stops, but peripherals keep their configuration.
+    WATCH_SLEEP_LEVEL_SLEEP_MODE,   ///< Sleep Mode: peripherals and pins are torn down, and app_setup rebuilds them.
+} watch_sleep_level_t;
+
+/** @brief Picks the cheapest way to wait out a gap until the next wake.
+  * @details Sleep Mode draws an order of magnitude less than STANDBY, but waking from it means running app_setup
+  *          to rebuild every peripheral, and that costs ACTIVE-mode current. For a short gap the rebuild costs more
+  *          than the sleep saves. This function weighs the two using the time app_setup actually took on recent
+  *          wakes from Sleep Mode (see watch_get_sleep_mode_setup_time), so a gap is only torn down for when it's
+  *          long enough to pay for itself.
+  * @param ms_until_wake How long until the next thing the app needs to wake for, in milliseconds.
+  * @param needs_main_clock true if something runs from the main clock in the meantime, like a dimmed LED or the
+  *                         buzzer. STANDBY would stop it, so the answer is always IDLE.
+  * @param alarm_wake true if the next wake comes from the RTC alarm or an external wake pin. If it comes from a
+  *                   periodic callback, Sleep Mode is ruled out, since it disables them.
+  * @return The sleep level to use. For WATCH_SLEEP_LEVEL_IDLE call watch_enter_idle_mode, for
+  *         WATCH_SLEEP_LEVEL_STANDBY call watch_enter_standby_mode, and for WATCH_SLEEP_LEVEL_SLEEP_MODE call
+  *         watch_enter_sleep_mode.
+  */
+watch_sleep_level_t watch_choose_sleep_level(uint32_t ms_until_wake, bool needs_main_clock, bool alarm_wake);
+
+/** @brief Returns how long app_setup takes after a wake from Sleep Mode, in microseconds.
+  * @details This is a running average of measured wakes. Until the first one has been measured, it's a
+  *          conservative guess.
+  */
+uint32_t watch_get_sleep_mode_setup_time(void);
+
+/** @brief Halts the CPU until the next interrupt, leaving the main clock and all peripherals running.
+  * @details Unlike STANDBY, IDLE keeps the PWM driver going, so a dimmed LED or the buzzer carry on while the CPU
+  *          waits. It's the right way to wait on a periodic callback while one of those is running, rather than
+  *          spinning on app_loop. Any enabled interrupt wakes the watch, after which this function returns.
+  */
+void watch_enter_idle_mode(void);
+
+/** @brief Enters STANDBY until the next interrupt, leaving all peripherals configured.
+  * @details This is what the main loop does when app_loop returns true; it's here for apps with a loop of their
+  *          own, like Movement's low energy mode. It calls app_prepare_for_standby before sleeping and
+  *          app_wake_from_standby after, but not app_setup, since nothing was torn down.
+  */
+void watch_enter_standby_mode(void);
+
 __attribute__((deprecated("Use watch_enter_sleep_mode or watch_enter_deep_sleep_mode instead")))
 void watch_enter_shallow_sleep(bool display_on);
 
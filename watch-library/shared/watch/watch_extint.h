@@ -48,7 +48,7 @@ typedef enum watch_interrupt_trigger {
     INTERRUPT_TRIGGER_BOTH,
 } watch_interrupt_trigger;
 
-/// @brief Enables the external interrupt controller.
+/// @brief Enables the external interrupt controller. If it's already enabled, registered callbacks are kept.
 void watch_enable_external_interrupts(void);
 
 /// @brief Disables the external interrupt controller.
@@ -102,5 +102,75 @@ uint32_t watch_i2c_read24(int16_t addr, uint8_t reg);
           bit packing, you may need to shuffle some bits around.
   */
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg);
+
+/** @brief A callback for the asynchronous I2C functions.
+  * @param status 0 if the transfer completed, or a negative error code (i.e. the device didn't acknowledge).
+  * @param context Whatever you passed in when you queued the transfer.
+  */
+typedef void (*watch_i2c_cb_t)(int32_t status, void *context);
+
+/// The number of asynchronous transfers that can be waiting on the bus at once.
+#define WATCH_I2C_QUEUE_LENGTH (8)
+
+/** @brief Queues a transfer of a series of values to a device on the I2C bus, and returns right away.
+  * @details The asynchronous functions hand the bus to the SERCOM's interrupt, which moves each byte as the bus
+  *          is ready for it, while the CPU sleeps in between. Transfers run one after another in the order you
+  *          queue them, and each one calls back (from interrupt context) when it's done; you may queue the next
+  *          one from there. The blocking functions above wait for the queue to drain before they use the bus,
+  *          so don't call them from a callback; anything queued while one of them has the bus starts once it's
+  *          done.
+  * @param addr The address of the device you wish to talk to.
+  * @param buf The data you wish to transmit. It must stay valid until the callback.
+  * @param length The number of bytes in buf that you wish to send.
+  * @param callback The function to call when the transfer is done, or NULL if you don't need to know.
+  * @param context Passed to the callback.
+  * @return true if the transfer was queued, false if the queue was full or length was 0.
+  */
+bool watch_i2c_send_async(int16_t addr, const uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context);
+
+/** @brief Queues a read of a series of values from a device on the I2C bus, and returns right away.
+  * @param addr The address of the device you wish to hear from.
+  * @param buf Storage for the incoming bytes. It must stay valid until the callback.
+  * @param length The number of bytes that you wish to receive.
+  * @param callback The function to call when the transfer is done, or NULL if you don't need to know.
+  * @param context Passed to the callback.
+  * @return true if the transfer was queued, false if the queue was full or length was 0.
+  * @see watch_i2c_send_async for details on how asynchronous transfers work.
+  */
+bool watch_i2c_receive_async(int16_t addr, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context);
+
+/** @brief Queues a write of a byte to a register in an I2C device, and returns right away.
+  * @param addr The address of the device you wish to address.
+  * @param reg The register on the device that you wish to set.
+  * @param data The value that you wish to set the register to. It's copied, so it needn't outlive the call.
+  * @param callback The function to call when the transfer is done, or NULL if you don't need to know.
+  * @param context Passed to the callback.
+  * @return true if the transfer was queued, false if the queue was full.
+  * @see watch_i2c_send_async for details on how asynchronous transfers work.
+  */
+bool watch_i2c_write8_async(int16_t addr, uint8_t reg, uint8_t data, watch_i2c_cb_t callback, void *context);
+
+/** @brief Queues a read of one or more consecutive registers from an I2C device, and returns right away.
+  * @details Sends the register address, then reads length bytes after a repeated start, all as one transfer.
+  * @param addr The address of the device you wish to address.
+  * @param reg The first register on the device that you wish to read.
+  * @param buf Storage for the incoming bytes. It must stay valid until the callback.
+  * @param length The number of bytes that you wish to receive.
+  * @param callback The function to call when the transfer is done, or NULL if you don't need to know.
+  * @param context Passed to the callback.
+  * @return true if the transfer was queued, false if the queue was full or length was 0.
+  * @see watch_i2c_send_async for details on how asynchronous transfers work.
+  */
+bool watch_i2c_read_async(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context);
+
+/** @brief Returns true while any asynchronous transfer is queued or in progress.
+  * @details The bus runs on the main clock, so an app that returns from its loop with transfers outstanding
+  *          should wait in IDLE rather than STANDBY; Movement does this for you.
+  */
+bool watch_i2c_is_busy(void);
+
+/** @brief Waits in IDLE for all queued asynchronous transfers to complete. Don't call it from a callback.
+  */
+void watch_i2c_wait(void);
 /// @}
 #endif
@@ -41,6 +41,47 @@ void _watch_disable_tcc(void);
 /// Called by main.c if plugged in to USB. You should not call this from your app.
 void _watch_enable_usb(void);
 
+/// Returns the frequency of the main clock in Hz: 4 MHz normally, 8 MHz with USB, 16 MHz at WATCH_PERFORMANCE_HIGH.
+uint32_t _watch_get_main_clock_frequency(void);
+
+/// Called by watch_request_performance after the main clock changes, so the TCC can re-derive its prescaler.
+void _watch_update_tcc_clock(void);
+
+/// Called by watch_request_performance after the main clock changes, so the ADC can re-derive its prescaler.
+void _watch_update_adc_clock(void);
+
+/// DMA and event system channels, and clock generators, claimed by watch library peripherals.
+#define WATCH_DMA_CHANNEL_ADC (0)
+#define WATCH_DMA_CHANNEL_SPI_RX (1)
+#define WATCH_DMA_CHANNEL_SPI_TX (2)
+#define WATCH_EVSYS_CHANNEL_ADC (0)
+#define WATCH_GCLK_ADC_SAMPLING (2)
+
+/// Routes the RTC's periodic event at this frequency (1-128 Hz) to the event system, or stops it if 0.
+void _watch_rtc_set_periodic_event(uint8_t frequency);
+
+/// On the simulator and host, where there's no event system, the RTC calls this for each periodic event.
+/// Returns true if it called back into the app, i.e. the CPU would have woken up.
+bool _watch_adc_handle_sampling_event(void);
+
+/// On the simulator and host, a scan's readings are taken right away, but the callback comes later, as it would from
+/// the DMA interrupt. The host asks whether one is pending, then has it called back; the latter returns true if it was.
+bool _watch_adc_scan_pending(void);
+bool _watch_adc_service_scan(void);
+
+/// Likewise, asynchronous I2C transfers complete one at a time when the simulator or host gets around to them; this
+/// completes the next one, returning false if there wasn't one.
+bool _watch_i2c_service_transfer(void);
+
+/// Called by watch_request_performance after the main clock changes, so the UART can re-derive its baud rate.
+void _watch_update_uart_clock(void);
+
+/// Called by watch_request_performance after the main clock changes, so the SPI bus can re-derive its clock.
+void _watch_update_spi_clock(void);
+
+/// Called by watch_enter_sleep_mode with the time app_setup took to rebuild the peripherals, in microseconds.
+void _watch_record_sleep_mode_setup_time(uint32_t us);
+
 // this function ends up getting called by printf to log stuff to the USB console.
 int _write(int file, char *ptr, int len);
 
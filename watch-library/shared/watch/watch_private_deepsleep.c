@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "driver_init.h"
+
+#include "watch_private.h"
+
+// what we assume app_setup costs until we've measured it, in microseconds. deliberately on the high side, so that
+// an unmeasured watch errs toward STANDBY rather than tearing down for a gap it can't pay back.
+#define WATCH_SLEEP_MODE_DEFAULT_SETUP_TIME (5000)
+
+// a gap has to be this many times longer than app_setup before Sleep Mode wins. ACTIVE draws something like ten
+// times the difference between STANDBY and Sleep Mode, so this is break-even with a bit of margin for the teardown.
+#define WATCH_SLEEP_MODE_BREAK_EVEN_FACTOR (16)
+
+static WATCH_INSTANCE_LOCAL uint32_t sleep_mode_setup_time = WATCH_SLEEP_MODE_DEFAULT_SETUP_TIME;
+static WATCH_INSTANCE_LOCAL bool sleep_mode_setup_time_measured = false;
+
+void _watch_record_sleep_mode_setup_time(uint32_t us) {
+    if (!sleep_mode_setup_time_measured) {
+        sleep_mode_setup_time = us;
+        sleep_mode_setup_time_measured = true;
+    } else {
+        // a running average, so one slow wake (say, a sensor that took a while to answer) doesn't swing the policy.
+        sleep_mode_setup_time = (sleep_mode_setup_time * 3 + us) / 4;
+    }
+}
+
+uint32_t watch_get_sleep_mode_setup_time(void) {
+    return sleep_mode_setup_time;
+}
+
+watch_sleep_level_t watch_choose_sleep_level(uint32_t ms_until_wake, bool needs_main_clock, bool alarm_wake) {
+    if (needs_main_clock) return WATCH_SLEEP_LEVEL_IDLE;
+    if (!alarm_wake) return WATCH_SLEEP_LEVEL_STANDBY;
+
+    uint64_t break_even = (uint64_t)sleep_mode_setup_time * WATCH_SLEEP_MODE_BREAK_EVEN_FACTOR;
+    if ((uint64_t)ms_until_wake * 1000 < break_even) return WATCH_SLEEP_LEVEL_STANDBY;
+
+    return WATCH_SLEEP_LEVEL_SLEEP_MODE;
+}
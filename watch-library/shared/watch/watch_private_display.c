@@ -33,7 +33,7 @@ static const uint32_t IndicatorSegments[] = {
     SLCD_SEGID(1, 10), // WATCH_INDICATOR_LAP
 };
 
-void watch_display_character(uint8_t character, uint8_t position) {
+WATCH_RAMFUNC void watch_display_character(uint8_t character, uint8_t position) {
     // special cases for positions 4 and 6
     if (position == 4 || position == 6) {
         if (character == '7') character = '&'; // "lowercase" 7
@@ -93,7 +93,7 @@ void watch_display_character(uint8_t character, uint8_t position) {
     else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
 }
 
-void watch_display_string(char *string, uint8_t position) {
+WATCH_RAMFUNC void watch_display_string(char *string, uint8_t position) {
     size_t i = 0;
     while(string[i] != 0) {
         watch_display_character(string[i], position + i);
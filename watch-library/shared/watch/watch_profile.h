@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _WATCH_PROFILE_H_INCLUDED
+#define _WATCH_PROFILE_H_INCLUDED
+////< @file watch_profile.h
+
+#include "watch.h"
+
+/** @addtogroup profile Wake Profiling
+  * @brief This section covers an optional instrumentation layer that measures how long the watch
+  *        stays awake each time an interrupt pulls it out of STANDBY.
+  * @details Every millisecond the SAM L22 spends in ACTIVE mode at 4 MHz costs roughly fifty times
+  *          the current it draws in STANDBY, so the length of each wake matters more to battery life
+  *          than almost anything else your app does. When you build with `make PROFILE=1`, the watch
+  *          library timestamps the entry to the RTC and EIC interrupt handlers and the return from
+  *          `app_loop` just before the device goes back to sleep, and sorts each of these wake
+  *          durations into log2 histograms, one per event type and one per watch face. Your app tags
+  *          each wake by calling watch_profile_set_event before handling it; the first tag in a given
+  *          wake wins, since that's the event that woke the device.
+  *
+  *          Durations are measured with TC1, which is clocked from the main clock and divided down to
+  *          tick once every WATCH_PROFILE_TICK_US microseconds. When watch_request_performance changes
+  *          the main clock, the divider changes with it, so a tick is the same length at any speed.
+  *          TC1 stops along with the main clock in STANDBY, so it only ever counts time spent awake.
+  *          A 16-bit count covers about 262 ms; longer wakes are recorded in the last bucket.
+  * @note Without PROFILE=1, all of these functions compile down to nothing, and the histogram
+  *       getters return NULL.
+  */
+/// @{
+
+#define WATCH_PROFILE_TICK_US (4)           ///< Resolution of the wake timer in microseconds.
+#define WATCH_PROFILE_NUM_BUCKETS (16)      ///< Bucket n counts wakes that lasted 2^n to 2^(n+1) - 1 ticks.
+#define WATCH_PROFILE_NUM_EVENT_TYPES (24)  ///< Event types at or above this number share the last histogram.
+#define WATCH_PROFILE_NUM_FACES (16)        ///< Face indexes at or above this number share the last histogram.
+
+/// A log2 histogram of wake durations, measured in ticks of WATCH_PROFILE_TICK_US.
+typedef struct {
+    uint32_t buckets[WATCH_PROFILE_NUM_BUCKETS];
+    uint32_t count;         ///< Number of wakes recorded.
+    uint32_t total_ticks;   ///< Sum of all wake durations, for computing the mean.
+    uint16_t max_ticks;     ///< Longest wake recorded.
+} watch_profile_histogram_t;
+
+#ifdef WATCH_WAKE_PROFILE
+
+/** @brief Tags the current wake with the event being handled and the watch face handling it.
+  * @param event_type The app's event type; in Movement, a movement_event_type_t.
+  * @param face_index The index of the watch face that will handle the event.
+  * @note Only the first call after each wake is recorded; later calls are ignored until the device
+  *       goes back to sleep.
+  */
+void watch_profile_set_event(uint8_t event_type, uint8_t face_index);
+
+/** @brief Returns the wake histogram for a given event type.
+  * @param event_type The event type you passed to watch_profile_set_event.
+  * @return A pointer to the histogram, which stays valid for the life of the app.
+  */
+const watch_profile_histogram_t *watch_profile_get_event_histogram(uint8_t event_type);
+
+/** @brief Returns the wake histogram for a given watch face.
+  * @param face_index The face index you passed to watch_profile_set_event.
+  * @return A pointer to the histogram, which stays valid for the life of the app.
+  */
+const watch_profile_histogram_t *watch_profile_get_face_histogram(uint8_t face_index);
+
+/// @brief Clears all histograms.
+void watch_profile_reset(void);
+
+/** @brief Prints every non-empty histogram with printf.
+  * @details When the watch is plugged into USB, this output goes to the USB CDC serial console.
+  *          Each line shows the count, mean and max in microseconds, followed by the bucket counts.
+  */
+void watch_profile_print(void);
+
+/// @brief Called by the watch library at the top of each interrupt handler that can wake the device.
+void _watch_profile_wake(void);
+
+/// @brief Called by the watch library when the app is done handling a wake, just before STANDBY.
+void _watch_profile_sleep(void);
+
+/// @brief Called by watch_request_performance after the main clock changes.
+void _watch_profile_update_clock(void);
+
+#else
+
+static inline void watch_profile_set_event(uint8_t event_type, uint8_t face_index) { (void) event_type; (void) face_index; }
+static inline const watch_profile_histogram_t *watch_profile_get_event_histogram(uint8_t event_type) { (void) event_type; return NULL; }
+static inline const watch_profile_histogram_t *watch_profile_get_face_histogram(uint8_t face_index) { (void) face_index; return NULL; }
+static inline void watch_profile_reset(void) {}
+static inline void watch_profile_print(void) {}
+static inline void _watch_profile_wake(void) {}
+static inline void _watch_profile_sleep(void) {}
+static inline void _watch_profile_update_clock(void) {}
+
+#endif
+
+/// @}
+#endif
@@ -73,6 +73,52 @@ void watch_clear_pixel(uint8_t com, uint8_t seg);
   */
 void watch_clear_display(void);
 
+/** @brief Copies the state of every segment on the display into a buffer.
+  * @param segments Storage for three 32-bit words, one for each common pin. Bit n of each word is the
+  *                 state of segment pin n.
+  */
+void watch_get_display_segments(uint32_t segments[3]);
+
+/** @brief Sets the state of every segment on the display at once.
+  * @param segments Three 32-bit words in the format returned by watch_get_display_segments.
+  */
+void watch_set_display_segments(const uint32_t segments[3]);
+
+/// Display power profiles, for watch_set_display_profile.
+typedef enum {
+    WATCH_DISPLAY_PROFILE_NORMAL = 0,   ///< The settings from hpl_slcd_config.h: ~45 Hz frames, full contrast.
+    WATCH_DISPLAY_PROFILE_LOW_POWER,    ///< ~32 Hz frames, lower contrast and a shorter bias buffer pulse.
+} watch_display_profile_t;
+
+/** @brief Sets the frame rate of the display.
+  * @details The SLCD draws current every time it drives a frame, so a lower frame rate means a lower
+  *          standby current. Below about 30 Hz, the display may start to flicker.
+  * @param hz The desired frame rate. The nearest available rate between 28 and 228 Hz will be used.
+  * @note Blinks and tick animations that are already running will speed up or slow down to match.
+  */
+void watch_set_display_frame_rate(uint8_t hz);
+
+/// @brief Returns the current frame rate of the display, in Hz.
+uint8_t watch_get_display_frame_rate(void);
+
+/** @brief Selects the waveform used to drive the display.
+  * @param low_power true for the low power (frame inversion) waveform, which is the default; false for
+  *                  the standard (bit inversion) waveform, which costs more current but may look crisper.
+  */
+void watch_set_display_low_power_waveform(bool low_power);
+
+/** @brief Sets the contrast of the display by adjusting the LCD drive voltage.
+  * @param contrast A value from 0 (2.51 V) to 15 (3.51 V). The default is 14. A lower drive voltage costs
+  *                 the charge pump less, especially as the battery voltage falls.
+  */
+void watch_set_display_contrast(uint8_t contrast);
+
+/** @brief Applies a set of frame rate, waveform, contrast and bias buffer settings in one step.
+  * @param profile WATCH_DISPLAY_PROFILE_LOW_POWER for when nobody's looking closely (like low energy mode,
+  *                or when the battery is getting low), or WATCH_DISPLAY_PROFILE_NORMAL to go back.
+  */
+void watch_set_display_profile(watch_display_profile_t profile);
+
 /** @brief Displays a string at the given position, starting from the top left. There are ten digits.
            A space in any position will clear that digit.
   * @param string A null-terminated string.
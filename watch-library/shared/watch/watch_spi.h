@@ -63,5 +63,49 @@ bool watch_spi_read(uint8_t *buf, uint16_t length);
   */
 bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length);
 
+/** @brief Sets the SPI clock. The bus comes up at 50 kHz, which any device on a breadboard can keep up with;
+  *        a flash chip on the board can go much faster.
+  * @param frequency The fastest clock you want, in Hz. The SPI clock is the main clock divided by an even
+  *                  number from 2 to 512, so the bus runs at the fastest of those that isn't over this.
+  * @return The actual clock, in Hz. If the main clock changes with watch_request_performance, the divider is
+  *         worked out again, aiming at the same frequency.
+  */
+uint32_t watch_spi_set_frequency(uint32_t frequency);
+
+/** @brief Returns the frequency most recently passed to watch_spi_set_frequency, or 50000 if it never was.
+  */
+uint32_t watch_spi_get_frequency(void);
+
+/** @brief A callback for watch_spi_transfer_async.
+  * @param status 0 if the transfer completed, or a negative error code if the DMA controller gave up on it.
+  * @param context Whatever you passed in when you started the transfer.
+  */
+typedef void (*watch_spi_cb_t)(int32_t status, void *context);
+
+/** @brief Starts a transfer on the SPI bus, and returns right away.
+  * @details Two DMA channels move the bytes between RAM and the SERCOM, so the CPU can sleep in IDLE for the
+  *          whole transfer, and only wakes for the callback (from interrupt context) at the end. You may start
+  *          the next transfer from there. The blocking functions above wait for a transfer in progress to
+  *          finish before they use the bus, so don't call them from a callback.
+  * @param data_out The bytes to send. It must stay valid until the callback. If NULL, sends 0xFF throughout.
+  * @param data_in Storage for incoming bytes. It must stay valid until the callback. If NULL, they're dropped.
+  * @param length The number of bytes to transfer.
+  * @param callback The function to call when the transfer is done, or NULL if you don't need to know.
+  * @param context Passed to the callback.
+  * @return true if the transfer started, false if another one was still running or length was 0.
+  * @note This function does not manage the chip select pin (usually A3).
+  */
+bool watch_spi_transfer_async(const uint8_t *data_out, uint8_t *data_in, uint16_t length, watch_spi_cb_t callback, void *context);
+
+/** @brief Returns true while an asynchronous transfer is in progress.
+  * @details The SERCOM runs on the main clock, so an app that returns from its loop with a transfer running
+  *          should wait in IDLE rather than STANDBY; Movement does this for you.
+  */
+bool watch_spi_is_busy(void);
+
+/** @brief Waits in IDLE for an asynchronous transfer in progress to complete. Don't call it from a callback.
+  */
+void watch_spi_wait(void);
+
 /// @}
 #endif
@@ -188,3 +188,107 @@ float watch_utility_thermistor_temperature(uint16_t value, bool highside, float
 
     return reading;
 }
+
+uint16_t watch_utility_isqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    // one bit of the root per step, from the top down.
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+// atan(2^-i) in degrees, as Q16 fixed point. sixteen steps get the angle to a couple thousandths of a degree.
+static const int32_t watch_utility_cordic_angles[] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+    14668, 7334, 3667, 1833, 917, 458, 229, 115,
+};
+// each step stretches the vector a little; over sixteen of them, by 1.64676. this is the inverse, in Q30.
+#define WATCH_UTILITY_CORDIC_INVERSE_GAIN (652032874)
+// vectors get scaled to just under 2^29 before we start, which leaves room for the gain and the 180 degree flip.
+#define WATCH_UTILITY_CORDIC_SCALE_BITS (29)
+
+// rotates (x, y) onto the positive x axis. returns the angle it took in Q16 degrees, and leaves the stretched length
+// in x; shift is how far the inputs were scaled up (or down, if negative) to use the full width of the registers.
+static int32_t _watch_utility_cordic_vector(int32_t *x_ptr, int32_t *y_ptr, int8_t *shift) {
+    int32_t x = *x_ptr, y = *y_ptr;
+    uint32_t ux = (x < 0) ? -(uint32_t)x : (uint32_t)x;
+    uint32_t uy = (y < 0) ? -(uint32_t)y : (uint32_t)y;
+    uint32_t largest = (ux > uy) ? ux : uy;
+    int32_t angle = 0;
+
+    *shift = 0;
+    if (largest == 0) {
+        *x_ptr = 0;
+        return 0;
+    }
+    while (largest >= (1UL << WATCH_UTILITY_CORDIC_SCALE_BITS)) {
+        largest >>= 1;
+        (*shift)--;
+    }
+    while (largest < (1UL << (WATCH_UTILITY_CORDIC_SCALE_BITS - 1))) {
+        largest <<= 1;
+        (*shift)++;
+    }
+    if (*shift < 0) {
+        x >>= -*shift;
+        y >>= -*shift;
+    } else {
+        x *= 1L << *shift;
+        y *= 1L << *shift;
+    }
+
+    // CORDIC only converges within about 99 degrees of the x axis, so the left half plane gets turned around first.
+    if (x < 0) {
+        angle = (y < 0) ? -180L * 65536 : 180L * 65536;
+        x = -x;
+        y = -y;
+    }
+    for (uint8_t i = 0; i < sizeof(watch_utility_cordic_angles) / sizeof(watch_utility_cordic_angles[0]); i++) {
+        int32_t dx = x >> i;
+        int32_t dy = y >> i;
+        if (y > 0) {
+            x += dy;
+            y -= dx;
+            angle += watch_utility_cordic_angles[i];
+        } else {
+            x -= dy;
+            y += dx;
+            angle -= watch_utility_cordic_angles[i];
+        }
+    }
+    *x_ptr = x;
+
+    return angle;
+}
+
+int16_t watch_utility_atan2(int32_t y, int32_t x) {
+    int8_t shift;
+    int32_t angle = _watch_utility_cordic_vector(&x, &y, &shift);
+
+    // Q16 degrees to hundredths, rounded.
+    return (angle * 100 + (1L << 15)) >> 16;
+}
+
+uint32_t watch_utility_magnitude(int32_t x, int32_t y) {
+    int8_t shift;
+    uint32_t magnitude;
+
+    _watch_utility_cordic_vector(&x, &y, &shift);
+    magnitude = ((uint64_t)x * WATCH_UTILITY_CORDIC_INVERSE_GAIN + (1UL << 29)) >> 30;
+
+    if (shift < 0) return magnitude << -shift;
+    if (shift == 0) return magnitude;
+
+    return (magnitude + (1UL << (shift - 1))) >> shift;
+}
@@ -124,4 +124,25 @@ watch_date_time watch_utility_date_time_convert_zone(watch_date_time date_time,
   */
 float watch_utility_thermistor_temperature(uint16_t value, bool highside, float b_coefficient, float nominal_temperature, float nominal_resistance, float series_resistance);
 
+/** @brief Returns the integer square root of a value, rounded down.
+  * @param value Any 32-bit value.
+  */
+uint16_t watch_utility_isqrt(uint32_t value);
+
+/** @brief Returns the angle of the vector (x, y) from the positive x axis, like atan2(y, x), in hundredths
+  *        of a degree from -18000 to 18000. Uses integer CORDIC, so it's safe to call on a chip with no FPU.
+  * @param y The y component of the vector.
+  * @param x The x component of the vector.
+  * @note Accurate to within 0.01 degrees; atan2(0, 0) returns 0.
+  */
+int16_t watch_utility_atan2(int32_t y, int32_t x);
+
+/** @brief Returns the length of the vector (x, y), like hypot(x, y), using the same CORDIC as atan2.
+  * @param x The x component of the vector.
+  * @param y The y component of the vector.
+  * @note Accurate to within 0.5 for vectors up to a few million long, and one part in 2^25 beyond that. For a third
+  *       component, pass the result back in with it: the length is under 2^32 for any inputs.
+  */
+uint32_t watch_utility_magnitude(int32_t x, int32_t y);
+
 #endif
@@ -3,3 +3,35 @@
 bool watch_is_buzzer_or_led_enabled(void) {
     return false;
 }
+
+static WATCH_INSTANCE_LOCAL watch_performance_t _watch_performance = WATCH_PERFORMANCE_NORMAL;
+
+void watch_request_performance(watch_performance_t level) {
+    _watch_performance = level;
+}
+
+watch_performance_t watch_get_performance(void) {
+    return _watch_performance;
+}
+
+static WATCH_INSTANCE_LOCAL uint16_t _watch_brownout_level = 2600;
+static WATCH_INSTANCE_LOCAL bool _watch_low_power_efficiency = true;
+
+void watch_configure_brownout_detector(uint16_t millivolts, uint8_t sample_interval) {
+    (void) sample_interval;
+    _watch_brownout_level = millivolts;
+}
+
+bool watch_get_brownout_detected(void) {
+    // there's no interrupt to catch the modeled VCC crossing the threshold, so check it when asked.
+    if (_watch_brownout_level == 0 || watch_get_vcc_voltage() >= _watch_brownout_level) return false;
+
+    // like the hardware, tripping disarms the detector and drops out of low power efficiency mode.
+    _watch_brownout_level = 0;
+    _watch_low_power_efficiency = false;
+    return true;
+}
+
+void watch_set_regulator_low_power_efficiency(bool enabled) {
+    _watch_low_power_efficiency = enabled;
+}
@@ -22,27 +22,368 @@
  * SOFTWARE.
  */
 
+#include <stdlib.h>
+#include <math.h>
 #include "watch_adc.h"
+#include "watch_adc_model.h"
+#include "watch_utility.h"
+#include "thermistor_driver.h"
 
-void watch_enable_adc(void) {}
+#if __EMSCRIPTEN__
+#include <emscripten.h>
+#include "watch_main_loop.h"
+#else
+#define EMSCRIPTEN_KEEPALIVE
+#endif
+
+typedef enum {
+    ADC_MODEL_CONSTANT = 0,
+    ADC_MODEL_RAMP,
+    ADC_MODEL_CSV,
+    ADC_MODEL_BATTERY,
+} adc_model_waveform_t;
+
+typedef struct {
+    float seconds;
+    float value;
+} adc_model_point_t;
+
+typedef struct {
+    adc_model_waveform_t waveform;
+    float start;
+    float end;
+    uint32_t period;
+    bool repeat;
+    bool thermistor;
+    adc_model_point_t *points;
+    uint32_t num_points;
+} adc_model_source_t;
+
+// A0-A4, then VCC. Pins default to 0 and VCC to a fresh-ish 3 volts, as before.
+#define ADC_MODEL_NUM_SOURCES (6)
+#define ADC_MODEL_VCC_INDEX (5)
+
+static WATCH_INSTANCE_LOCAL adc_model_source_t adc_model_sources[ADC_MODEL_NUM_SOURCES] = {
+    [ADC_MODEL_VCC_INDEX] = { .waveform = ADC_MODEL_CONSTANT, .start = 3000 },
+};
+static WATCH_INSTANCE_LOCAL uint32_t adc_model_time_scale = 1;
+static WATCH_INSTANCE_LOCAL uint32_t adc_model_epoch = 0;
+static WATCH_INSTANCE_LOCAL uint8_t adc_num_samples_log2 = 4;
+
+static WATCH_INSTANCE_LOCAL uint8_t adc_sampling_pin;
+static WATCH_INSTANCE_LOCAL uint16_t *adc_sampling_buffer = NULL;
+static WATCH_INSTANCE_LOCAL uint16_t adc_sampling_count;
+static WATCH_INSTANCE_LOCAL uint16_t adc_sampling_index;
+static WATCH_INSTANCE_LOCAL watch_adc_sampling_cb_t adc_sampling_callback;
+static WATCH_INSTANCE_LOCAL uint16_t adc_window_lower;
+static WATCH_INSTANCE_LOCAL uint16_t adc_window_upper;
+static WATCH_INSTANCE_LOCAL ext_irq_cb_t adc_window_callback;
+static WATCH_INSTANCE_LOCAL uint16_t *adc_scan_results = NULL;
+static WATCH_INSTANCE_LOCAL uint8_t adc_scan_count;
+static WATCH_INSTANCE_LOCAL watch_adc_scan_cb_t adc_scan_callback;
+
+static int8_t _watch_adc_model_index(uint8_t pin) {
+    switch (pin) {
+        case A0:
+            return 0;
+        case A1:
+            return 1;
+        case A2:
+            return 2;
+        case A3:
+            return 3;
+        case A4:
+            return 4;
+        case WATCH_ADC_MODEL_VCC:
+            return ADC_MODEL_VCC_INDEX;
+        default:
+            return -1;
+    }
+}
+
+static uint32_t _watch_adc_model_now(void) {
+    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
+}
+
+static float _watch_adc_model_time(void) {
+    if (adc_model_epoch == 0) adc_model_epoch = _watch_adc_model_now();
+    return (float)(_watch_adc_model_now() - adc_model_epoch) * adc_model_time_scale;
+}
+
+static adc_model_source_t *_watch_adc_model_reset_source(uint8_t pin, adc_model_waveform_t waveform) {
+    int8_t index = _watch_adc_model_index(pin);
+    if (index < 0) return NULL;
+
+    adc_model_source_t *source = &adc_model_sources[index];
+    free(source->points);
+    source->points = NULL;
+    source->num_points = 0;
+    source->waveform = waveform;
+
+    return source;
+}
+
+static float _watch_adc_model_evaluate(const adc_model_source_t *source, float t) {
+    switch (source->waveform) {
+        case ADC_MODEL_CONSTANT:
+            return source->start;
+        case ADC_MODEL_RAMP:
+            if (source->period == 0) return source->end;
+            if (source->repeat) t = fmodf(t, source->period);
+            else if (t >= source->period) return source->end;
+            return source->start + (source->end - source->start) * t / source->period;
+        case ADC_MODEL_CSV:
+        {
+            const adc_model_point_t *points = source->points;
+            uint32_t n = source->num_points;
+            if (source->repeat && points[n - 1].seconds > 0) t = fmodf(t, points[n - 1].seconds);
+            if (t <= points[0].seconds) return points[0].value;
+            for (uint32_t i = 1; i < n; i++) {
+                if (t < points[i].seconds) {
+                    float fraction = (t - points[i - 1].seconds) / (points[i].seconds - points[i - 1].seconds);
+                    return points[i - 1].value + (points[i].value - points[i - 1].value) * fraction;
+                }
+            }
+            return points[n - 1].value;
+        }
+        case ADC_MODEL_BATTERY:
+        {
+            // lithium coin cells sit on a plateau for most of their life, losing about a third of their usable
+            // voltage swing over the first 80% of capacity, then fall off a cliff.
+            float x = source->period ? t / source->period : 1;
+            float discharged;
+            if (x < 0.8) discharged = x * 0.3 / 0.8;
+            else discharged = 0.3 + (x - 0.8) * 0.7 / 0.2;
+            if (discharged > 1) discharged = 1;
+            return source->start - (source->start - source->end) * discharged;
+        }
+    }
+
+    return 0;
+}
+
+static float _watch_adc_model_thermistor_level(float celsius) {
+    float resistance = THERMISTOR_NOMINAL_RESISTANCE * expf(THERMISTOR_B_COEFFICIENT * (1.0 / (celsius + 273.15) - 1.0 / (THERMISTOR_NOMINAL_TEMPERATURE + 273.15)));
+
+    // these are the inverse of the divider math in watch_utility_thermistor_temperature.
+    if (THERMISTOR_HIGH_SIDE) return 65472.0 * THERMISTOR_SERIES_RESISTANCE / (resistance + THERMISTOR_SERIES_RESISTANCE);
+    else return 65535.0 * resistance / (resistance + THERMISTOR_SERIES_RESISTANCE);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_adc_model_set_time_scale(uint32_t scale) {
+    adc_model_time_scale = scale ? scale : 1;
+    adc_model_epoch = _watch_adc_model_now();
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_adc_model_set_constant(uint8_t pin, float value) {
+    adc_model_source_t *source = _watch_adc_model_reset_source(pin, ADC_MODEL_CONSTANT);
+    if (source == NULL) return;
+    source->start = value;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_adc_model_set_ramp(uint8_t pin, float start, float end, uint32_t period, bool repeat) {
+    adc_model_source_t *source = _watch_adc_model_reset_source(pin, ADC_MODEL_RAMP);
+    if (source == NULL) return;
+    source->start = start;
+    source->end = end;
+    source->period = period;
+    source->repeat = repeat;
+}
+
+EMSCRIPTEN_KEEPALIVE
+bool watch_adc_model_load_csv(uint8_t pin, const char *csv, bool repeat) {
+    if (_watch_adc_model_index(pin) < 0 || csv == NULL) return false;
+
+    uint32_t capacity = 1;
+    for (const char *c = csv; *c; c++) if (*c == '\n') capacity++;
+    adc_model_point_t *points = malloc(capacity * sizeof(adc_model_point_t));
+    if (points == NULL) return false;
+
+    uint32_t n = 0;
+    const char *line = csv;
+    while (*line && n < capacity) {
+        char *end;
+        float seconds = strtof(line, &end);
+        if (end != line && *end == ',') {
+            const char *value_start = end + 1;
+            float value = strtof(value_start, &end);
+            // skip header lines and anything that goes backwards in time.
+            if (end != value_start && (n == 0 || seconds > points[n - 1].seconds)) {
+                points[n].seconds = seconds;
+                points[n].value = value;
+                n++;
+            }
+        }
+        while (*line && *line != '\n') line++;
+        if (*line) line++;
+    }
+
+    if (n == 0) {
+        free(points);
+        return false;
+    }
+
+    adc_model_source_t *source = _watch_adc_model_reset_source(pin, ADC_MODEL_CSV);
+    source->points = points;
+    source->num_points = n;
+    source->repeat = repeat;
+
+    return true;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_adc_model_set_thermistor(uint8_t pin, bool enabled) {
+    int8_t index = _watch_adc_model_index(pin);
+    if (index < 0 || index == ADC_MODEL_VCC_INDEX) return;
+    adc_model_sources[index].thermistor = enabled;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_adc_model_set_battery(uint16_t fresh_mv, uint16_t empty_mv, uint32_t lifetime) {
+    adc_model_source_t *source = _watch_adc_model_reset_source(WATCH_ADC_MODEL_VCC, ADC_MODEL_BATTERY);
+    source->start = fresh_mv;
+    source->end = empty_mv;
+    source->period = lifetime;
+}
+
+void watch_enable_adc(void) {
+    adc_num_samples_log2 = 4;
+}
 
 void watch_enable_analog_input(const uint8_t pin) {}
 
 uint16_t watch_get_analog_pin_level(const uint8_t pin) {
-    return 0;
+    int8_t index = _watch_adc_model_index(pin);
+    if (index < 0 || index == ADC_MODEL_VCC_INDEX) return 0;
+
+    const adc_model_source_t *source = &adc_model_sources[index];
+    float value = _watch_adc_model_evaluate(source, _watch_adc_model_time());
+    if (source->thermistor) value = _watch_adc_model_thermistor_level(value);
+
+    if (value < 0) value = 0;
+    if (value > 65535) value = 65535;
+
+    // the model produces a 16-bit value; with fewer than 16 samples accumulated, the hardware returns fewer bits.
+    if (adc_num_samples_log2 < 4) return (uint16_t)value >> (4 - adc_num_samples_log2);
+    return (uint16_t)value;
 }
 
-void watch_set_analog_num_samples(uint16_t samples) {}
+void watch_set_analog_num_samples(uint16_t samples) {
+    if (__builtin_popcount(samples) != 1) return;
+    uint8_t sample_val = __builtin_ctz(samples);
+    if (sample_val <= 10) adc_num_samples_log2 = sample_val;
+}
 
 void watch_set_analog_sampling_length(uint8_t cycles) {}
 
 void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {}
 
 uint16_t watch_get_vcc_voltage(void) {
-    // TODO: (a2) hook to UI
-    return 3000;
+    float value = _watch_adc_model_evaluate(&adc_model_sources[ADC_MODEL_VCC_INDEX], _watch_adc_model_time());
+
+    if (value < 0) return 0;
+    return (uint16_t)value;
 }
 
 inline void watch_disable_analog_input(const uint8_t pin) {}
 
 inline void watch_disable_adc(void) {}
+
+void watch_adc_start_sampling(const uint8_t pin, uint8_t frequency, uint16_t *buffer, uint16_t count, watch_adc_sampling_cb_t callback) {
+    int8_t index = _watch_adc_model_index(pin);
+    if (index < 0 || index == ADC_MODEL_VCC_INDEX) return;
+    if (__builtin_popcount(frequency) != 1 || buffer == NULL || count == 0 || callback == NULL) return;
+
+    adc_sampling_pin = pin;
+    adc_sampling_buffer = buffer;
+    adc_sampling_count = count;
+    adc_sampling_index = 0;
+    adc_sampling_callback = callback;
+    _watch_rtc_set_periodic_event(frequency);
+}
+
+void watch_adc_set_sampling_window(uint16_t lower, uint16_t upper, ext_irq_cb_t callback) {
+    adc_window_lower = lower;
+    adc_window_upper = upper;
+    adc_window_callback = callback;
+}
+
+uint16_t watch_adc_stop_sampling(void) {
+    if (adc_sampling_buffer == NULL) return 0;
+
+    _watch_rtc_set_periodic_event(0);
+    adc_sampling_buffer = NULL;
+    adc_window_callback = NULL;
+
+    return adc_sampling_index;
+}
+
+#if __EMSCRIPTEN__
+static void watch_invoke_scan_callback(void *userData) {
+    (void) userData;
+    if (_watch_adc_service_scan()) resume_main_loop();
+}
+#endif
+
+bool watch_adc_start_scan(const uint8_t *pins, uint8_t count, uint16_t *results, watch_adc_scan_cb_t callback) {
+    if (pins == NULL || count == 0 || count > 8 || results == NULL || callback == NULL) return false;
+    if (adc_sampling_buffer != NULL || adc_scan_results != NULL) return false;
+    for (uint8_t i = 0; i < count; i++) {
+        int8_t index = _watch_adc_model_index(pins[i]);
+        if (index < 0 || index == ADC_MODEL_VCC_INDEX) return false;
+    }
+
+    // there's no conversion time to model, so take the readings now; the callback still comes later.
+    for (uint8_t i = 0; i < count; i++) results[i] = watch_get_analog_pin_level(pins[i]);
+    adc_scan_results = results;
+    adc_scan_count = count;
+    adc_scan_callback = callback;
+#if __EMSCRIPTEN__
+    emscripten_async_call(watch_invoke_scan_callback, NULL, 0);
+#endif
+
+    return true;
+}
+
+bool _watch_adc_scan_pending(void) {
+    return adc_scan_results != NULL;
+}
+
+bool _watch_adc_service_scan(void) {
+    if (adc_scan_results == NULL) return false;
+
+    uint16_t *results = adc_scan_results;
+    adc_scan_results = NULL;
+    adc_scan_callback(results, adc_scan_count);
+
+    return true;
+}
+
+bool watch_adc_is_busy(void) {
+    return adc_sampling_buffer != NULL || adc_scan_results != NULL;
+}
+
+bool _watch_adc_handle_sampling_event(void) {
+    if (adc_sampling_buffer == NULL) return false;
+
+    bool woke = false;
+    uint16_t value = watch_get_analog_pin_level(adc_sampling_pin);
+    adc_sampling_buffer[adc_sampling_index++] = value;
+
+    if (adc_window_callback != NULL && (value < adc_window_lower || value > adc_window_upper)) {
+        ext_irq_cb_t callback = adc_window_callback;
+        adc_window_callback = NULL;
+        callback();
+        woke = true;
+    }
+    if (adc_sampling_buffer != NULL && adc_sampling_index >= adc_sampling_count) {
+        adc_sampling_index = 0;
+        adc_sampling_callback(adc_sampling_buffer, adc_sampling_count);
+        woke = true;
+    }
+
+    return woke;
+}
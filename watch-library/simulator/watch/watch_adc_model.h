@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_ADC_MODEL_H_INCLUDED
+#define _WATCH_ADC_MODEL_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Simulator-only analog front end. Each analog pin (A0-A4) and the VCC rail can be driven by a waveform that is
+// evaluated against model time, which is the number of seconds on the watch's RTC since the model was last reset,
+// multiplied by the time scale. The functions below are exported, so you can script them from the browser console,
+// i.e. Module.ccall('watch_adc_model_set_ramp', null, ['number', 'number', 'number', 'number', 'number'], [16, 0, 65535, 60, 1]);
+
+// pass this in place of an analog pin to configure the VCC rail (values in millivolts).
+#define WATCH_ADC_MODEL_VCC (0xFF)
+
+/// Resets model time to zero and sets the number of model seconds that elapse per second of RTC time (default 1).
+void watch_adc_model_set_time_scale(uint32_t scale);
+
+/// Drives the pin with a constant value.
+void watch_adc_model_set_constant(uint8_t pin, float value);
+
+/// Drives the pin with a linear ramp from start to end over period seconds; if repeat is false, it holds the end value.
+void watch_adc_model_set_ramp(uint8_t pin, float start, float end, uint32_t period, bool repeat);
+
+/// Plays back a CSV of "seconds,value" lines, interpolating linearly between points. Returns false if no points parsed.
+bool watch_adc_model_load_csv(uint8_t pin, const char *csv, bool repeat);
+
+/** If enabled, the pin's waveform is treated as a temperature profile in degrees Celsius, and the pin reads back the
+  * level of the thermistor voltage divider described in thermistor_driver.h at that temperature.
+  */
+void watch_adc_model_set_thermistor(uint8_t pin, bool enabled);
+
+/** Drives the VCC rail with a coin cell discharge curve: a long, gentle slope from fresh_mv followed by a knee down to
+  * empty_mv at the end of lifetime seconds.
+  */
+void watch_adc_model_set_battery(uint16_t fresh_mv, uint16_t empty_mv, uint32_t lifetime);
+
+#endif
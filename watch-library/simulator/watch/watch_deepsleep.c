@@ -73,6 +73,19 @@ void watch_enter_sleep_mode(void) {
     app_wake_from_standby();
 }
 
+void watch_enter_idle_mode(void) {
+    // nothing to do here; the browser's animation frame loop stands in for the CPU.
+}
+
+void watch_enter_standby_mode(void) {
+    app_prepare_for_standby();
+
+    // enter standby (4); unlike sleep mode, everything stays configured.
+    // sleep(4);
+
+    app_wake_from_standby();
+}
+
 void watch_enter_deep_sleep_mode(void) {
     // identical to sleep mode except we disable the LCD first.
     // TODO: (a2) hook to UI
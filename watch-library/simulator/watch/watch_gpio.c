@@ -23,8 +23,9 @@
  */
 
 #include "watch_gpio.h"
+#include "watch_spi_flash_model.h"
 
-static bool pin_levels[UINT8_MAX];
+static WATCH_INSTANCE_LOCAL bool pin_levels[UINT8_MAX];
 
 void watch_enable_digital_input(const uint8_t pin) {}
 
@@ -43,5 +44,7 @@ void watch_enable_digital_output(const uint8_t pin) {}
 void watch_disable_digital_output(const uint8_t pin) {}
 
 void watch_set_pin_level(const uint8_t pin, const bool level) {
+    // A3 is the chip select for the SPI flash model.
+    if (pin == A3) spi_flash_model_set_chip_select(level);
     pin_levels[pin] = level;
 }
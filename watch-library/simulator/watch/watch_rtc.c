@@ -30,6 +30,7 @@
 
 static double time_offset = 0;
 static long tick_callbacks[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static long tick_event_interval_id = -1;
 
 static long alarm_interval_id = -1;
 static long alarm_timeout_id = -1;
@@ -104,6 +105,21 @@ void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequen
     tick_callbacks[per_n] = emscripten_set_interval(watch_invoke_periodic_callback, interval, (void *)callback);
 }
 
+static void watch_invoke_periodic_event(void *userData) {
+    (void) userData;
+    // there's no event system here, so deliver the event to its only user ourselves.
+    if (_watch_adc_handle_sampling_event()) resume_main_loop();
+}
+
+void _watch_rtc_set_periodic_event(uint8_t frequency) {
+    if (tick_event_interval_id != -1) {
+        emscripten_clear_interval(tick_event_interval_id);
+        tick_event_interval_id = -1;
+    }
+    if (__builtin_popcount(frequency) != 1) return;
+    tick_event_interval_id = emscripten_set_interval(watch_invoke_periodic_event, 1000 / frequency, NULL);
+}
+
 void watch_rtc_disable_periodic_callback(uint8_t frequency) {
     if (__builtin_popcount(frequency) != 1) return;
     uint8_t per_n = __builtin_clz(frequency << 24);
@@ -37,12 +37,14 @@ static bool blink_state;
 static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
+static uint32_t segment_data[3];
 
 void watch_enable_display(void) {
     watch_clear_display();
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
+    segment_data[com] |= 1ul << seg;
     EM_ASM({
         document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
             .forEach((e) => e.style.opacity = 1);
@@ -50,6 +52,7 @@ void watch_set_pixel(uint8_t com, uint8_t seg) {
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    segment_data[com] &= ~(1ul << seg);
     EM_ASM({
         document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
             .forEach((e) => e.style.opacity = 0);
@@ -57,12 +60,26 @@ void watch_clear_pixel(uint8_t com, uint8_t seg) {
 }
 
 void watch_clear_display(void) {
+    segment_data[0] = segment_data[1] = segment_data[2] = 0;
     EM_ASM({
         document.querySelectorAll("[data-com][data-seg]")
             .forEach((e) => e.style.opacity = 0);
     });
 }
 
+void watch_get_display_segments(uint32_t segments[3]) {
+    for (uint8_t com = 0; com < 3; com++) segments[com] = segment_data[com];
+}
+
+void watch_set_display_segments(const uint32_t segments[3]) {
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            if (segments[com] & (1ul << seg)) watch_set_pixel(com, seg);
+            else if (segment_data[com] & (1ul << seg)) watch_clear_pixel(com, seg);
+        }
+    }
+}
+
 static void watch_invoke_blink_callback(void *userData) {
     blink_state = !blink_state;
     watch_display_character(blink_state ? blink_character : ' ', 7);
@@ -115,3 +132,30 @@ void watch_stop_tick_animation(void) {
 
     watch_display_character(' ', 8);
 }
+
+// there's no glass to drive here; just keep track of the settings so the getters are honest.
+static uint8_t display_frame_rate = SLCD_FRAME_FREQUENCY;
+
+void watch_set_display_frame_rate(uint8_t hz) {
+    if (hz == 0) hz = 1;
+    int16_t ckdiv = (SLCD_FRAME_FREQUENCY * (CONF_SLCD_CKDIV + 1) + hz / 2) / hz - 1;
+    if (ckdiv < 0) ckdiv = 0;
+    if (ckdiv > 7) ckdiv = 7;
+    display_frame_rate = SLCD_FRAME_FREQUENCY * (CONF_SLCD_CKDIV + 1) / (ckdiv + 1);
+}
+
+uint8_t watch_get_display_frame_rate(void) {
+    return display_frame_rate;
+}
+
+void watch_set_display_low_power_waveform(bool low_power) {
+    (void) low_power;
+}
+
+void watch_set_display_contrast(uint8_t contrast) {
+    (void) contrast;
+}
+
+void watch_set_display_profile(watch_display_profile_t profile) {
+    watch_set_display_frame_rate(profile == WATCH_DISPLAY_PROFILE_LOW_POWER ? 32 : SLCD_FRAME_FREQUENCY);
+}
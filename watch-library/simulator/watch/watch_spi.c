@@ -23,13 +23,74 @@
  */
 
 #include "watch_spi.h"
+#include "watch_spi_flash_model.h"
+#ifdef WATCH_HOST
+#include "watch_host.h"
+#endif
 
-void watch_enable_spi(void) {}
+static WATCH_INSTANCE_LOCAL bool spi_enabled = false;
+static WATCH_INSTANCE_LOCAL uint32_t spi_frequency = 50000;
 
-void watch_disable_spi(void) {}
+void watch_enable_spi(void) {
+    spi_enabled = true;
+}
 
-bool watch_spi_write(const uint8_t *buf, uint16_t length) { return false; }
+void watch_disable_spi(void) {
+    spi_enabled = false;
+}
 
-bool watch_spi_read(uint8_t *buf, uint16_t length) { return false; }
+// the only device on the simulated bus is the SPI flash model. the host build bills the time the bytes take to clock
+// out, so that anything polling the flash sees its program and erase times go by.
+static void _watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
+    spi_flash_model_transfer(data_out, data_in, length);
+#ifdef WATCH_HOST
+    _watch_host_delay(length * 8 * WATCH_HOST_NS_PER_SECOND / spi_frequency);
+#endif
+}
 
-bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) { return false; }
+bool watch_spi_write(const uint8_t *buf, uint16_t length) {
+    if (!spi_enabled) return false;
+    _watch_spi_transfer(buf, NULL, length);
+    return true;
+}
+
+bool watch_spi_read(uint8_t *buf, uint16_t length) {
+    if (!spi_enabled) return false;
+    _watch_spi_transfer(NULL, buf, length);
+    return true;
+}
+
+bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
+    if (!spi_enabled) return false;
+    _watch_spi_transfer(data_out, data_in, length);
+    return true;
+}
+
+// the model has no clock to speak of; as on hardware with a 4 MHz main clock, the fastest we could go is 2 MHz.
+uint32_t watch_spi_set_frequency(uint32_t frequency) {
+    if (frequency == 0) return 0;
+    spi_frequency = frequency;
+    for (uint32_t divider = 2; divider <= 512; divider += 2) {
+        if (4000000 / divider <= frequency) return 4000000 / divider;
+    }
+    return 4000000 / 512;
+}
+
+uint32_t watch_spi_get_frequency(void) {
+    return spi_frequency;
+}
+
+// there's no DMA to wait on, so the transfer happens right away, and the callback comes before this returns.
+bool watch_spi_transfer_async(const uint8_t *data_out, uint8_t *data_in, uint16_t length, watch_spi_cb_t callback, void *context) {
+    if (!spi_enabled || length == 0) return false;
+    _watch_spi_transfer(data_out, data_in, length);
+    if (callback != NULL) callback(0, context);
+    return true;
+}
+
+bool watch_spi_is_busy(void) {
+    return false;
+}
+
+void watch_spi_wait(void) {
+}
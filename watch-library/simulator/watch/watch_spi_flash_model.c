@@ -0,0 +1,288 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "watch_spi_flash_model.h"
+#include "spiflash.h"
+
+#if __EMSCRIPTEN__
+#include <emscripten.h>
+#elif defined(WATCH_HOST)
+#include "watch_host.h"
+#else
+#include <time.h>
+#endif
+
+static WATCH_INSTANCE_LOCAL uint8_t *flash_memory = NULL;
+static WATCH_INSTANCE_LOCAL FILE *flash_file = NULL;
+
+static WATCH_INSTANCE_LOCAL bool write_enabled = false;
+static WATCH_INSTANCE_LOCAL bool reset_enabled = false;
+static WATCH_INSTANCE_LOCAL bool powered_down = false;
+static WATCH_INSTANCE_LOCAL double busy_until = 0;
+
+// the command in flight, since the last time chip select went low.
+static WATCH_INSTANCE_LOCAL bool selected = false;
+static WATCH_INSTANCE_LOCAL bool in_command = false;
+static WATCH_INSTANCE_LOCAL bool command_ignored = false;
+static WATCH_INSTANCE_LOCAL uint8_t command;
+static WATCH_INSTANCE_LOCAL uint32_t command_index;
+static WATCH_INSTANCE_LOCAL uint32_t command_address;
+static WATCH_INSTANCE_LOCAL uint8_t page_buffer[SPI_FLASH_MODEL_PAGE_SIZE];
+static WATCH_INSTANCE_LOCAL bool page_buffer_dirty[SPI_FLASH_MODEL_PAGE_SIZE];
+static WATCH_INSTANCE_LOCAL bool page_buffer_used;
+
+static double _spi_flash_model_now(void) {
+#if __EMSCRIPTEN__
+    return emscripten_get_now();
+#elif defined(WATCH_HOST)
+    return watch_host_get_time() / 1000000.0;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+}
+
+static bool _spi_flash_model_is_busy(void) {
+    return _spi_flash_model_now() < busy_until;
+}
+
+static void _spi_flash_model_init(void) {
+    if (flash_memory != NULL) return;
+
+    flash_memory = malloc(SPI_FLASH_MODEL_SIZE);
+    memset(flash_memory, 0xFF, SPI_FLASH_MODEL_SIZE);
+
+#ifdef WATCH_HOST
+    // every watch in the fleet gets a backing file of its own.
+    char path[64];
+    snprintf(path, sizeof(path), SPI_FLASH_MODEL_HOST_PATH, watch_host_get_instance());
+#else
+    const char *path = SPI_FLASH_MODEL_PATH;
+#endif
+
+    // a fresh image starts erased; an existing one is loaded as-is (a short file just means the tail is erased).
+    flash_file = fopen(path, "r+b");
+    if (flash_file != NULL) {
+        size_t unused = fread(flash_memory, 1, SPI_FLASH_MODEL_SIZE, flash_file);
+        (void)unused;
+    } else {
+        flash_file = fopen(path, "w+b");
+    }
+    if (flash_file == NULL) {
+        printf("spi flash model: could not open %s, contents will not persist\n", path);
+        return;
+    }
+    fseek(flash_file, 0, SEEK_SET);
+    fwrite(flash_memory, 1, SPI_FLASH_MODEL_SIZE, flash_file);
+    fflush(flash_file);
+}
+
+static void _spi_flash_model_persist(uint32_t address, uint32_t length) {
+    if (flash_file == NULL) return;
+    fseek(flash_file, address, SEEK_SET);
+    fwrite(flash_memory + address, 1, length, flash_file);
+    fflush(flash_file);
+}
+
+static void _spi_flash_model_erase(uint32_t size, double duration) {
+    uint32_t start = command_address & ~(size - 1);
+    memset(flash_memory + start, 0xFF, size);
+    _spi_flash_model_persist(start, size);
+    busy_until = _spi_flash_model_now() + duration;
+}
+
+static void _spi_flash_model_program(void) {
+    uint32_t page_start = command_address & ~(SPI_FLASH_MODEL_PAGE_SIZE - 1);
+    // NOR flash can only clear bits; anything else takes an erase.
+    for (uint16_t i = 0; i < SPI_FLASH_MODEL_PAGE_SIZE; i++) {
+        if (page_buffer_dirty[i]) flash_memory[page_start + i] &= page_buffer[i];
+    }
+    _spi_flash_model_persist(page_start, SPI_FLASH_MODEL_PAGE_SIZE);
+    busy_until = _spi_flash_model_now() + SPI_FLASH_MODEL_PAGE_PROGRAM_TIME;
+}
+
+static bool _spi_flash_model_has_address(void) {
+    return command_index >= 3;
+}
+
+static uint8_t _spi_flash_model_begin(uint8_t byte) {
+    in_command = true;
+    command = byte;
+    command_index = 0;
+    command_address = 0;
+    page_buffer_used = false;
+
+    // while powered down, the chip only listens for the wake command.
+    // while busy, it only answers status reads.
+    command_ignored = (powered_down && command != CMD_WAKE) ||
+                      (!powered_down && _spi_flash_model_is_busy() && command != CMD_READ_STATUS);
+
+    return 0xFF;
+}
+
+static uint8_t _spi_flash_model_exchange(uint8_t byte) {
+    if (!in_command) return _spi_flash_model_begin(byte);
+    if (command_ignored) return 0xFF;
+
+    uint32_t index = command_index++;
+    static const uint8_t jedec_id[] = SPI_FLASH_MODEL_JEDEC_ID;
+
+    switch (command) {
+        case CMD_READ_DATA:
+        case CMD_FAST_READ_DATA:
+        case CMD_PAGE_PROGRAM:
+        case CMD_SECTOR_ERASE:
+        case CMD_BLOCK_ERASE_32K:
+        case CMD_BLOCK_ERASE_64K:
+            if (index < 3) {
+                command_address = ((command_address << 8) | byte) & (SPI_FLASH_MODEL_SIZE - 1);
+                return 0xFF;
+            }
+            break;
+        default:
+            break;
+    }
+
+    switch (command) {
+        case CMD_FAST_READ_DATA:
+            // one dummy byte after the address
+            if (index == 3) return 0xFF;
+            // fall through
+        case CMD_READ_DATA:
+        {
+            uint8_t value = flash_memory[command_address];
+            command_address = (command_address + 1) & (SPI_FLASH_MODEL_SIZE - 1);
+            return value;
+        }
+        case CMD_PAGE_PROGRAM:
+        {
+            // the address wraps within the page, so only the last 256 bytes clocked in are kept.
+            uint8_t column = (command_address + (index - 3)) & (SPI_FLASH_MODEL_PAGE_SIZE - 1);
+            page_buffer[column] = byte;
+            page_buffer_dirty[column] = true;
+            page_buffer_used = true;
+            return 0xFF;
+        }
+        case CMD_READ_STATUS:
+            return (_spi_flash_model_is_busy() ? SPI_FLASH_STATUS_WIP : 0) | (write_enabled ? SPI_FLASH_STATUS_WEL : 0);
+        case CMD_READ_STATUS2:
+            return 0;
+        case CMD_READ_JEDEC_ID:
+            return index < sizeof(jedec_id) ? jedec_id[index] : 0xFF;
+        case CMD_WAKE:
+            // release from power-down; with three dummy bytes, it also reads out the device ID.
+            return index >= 3 ? SPI_FLASH_MODEL_DEVICE_ID : 0xFF;
+        default:
+            return 0xFF;
+    }
+}
+
+void spi_flash_model_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
+    _spi_flash_model_init();
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t value = selected ? _spi_flash_model_exchange(data_out ? data_out[i] : 0xFF) : 0xFF;
+        if (data_in) data_in[i] = value;
+    }
+}
+
+void spi_flash_model_close(void) {
+    if (flash_file != NULL) fclose(flash_file);
+    free(flash_memory);
+    flash_file = NULL;
+    flash_memory = NULL;
+    write_enabled = reset_enabled = powered_down = false;
+    busy_until = 0;
+    in_command = false;
+}
+
+void spi_flash_model_set_chip_select(bool level) {
+    if (!level) {
+        selected = true;
+        return;
+    }
+
+    selected = false;
+    if (!in_command) return;
+    in_command = false;
+
+    if (command_ignored) return;
+
+    switch (command) {
+        case CMD_ENABLE_WRITE:
+            write_enabled = true;
+            break;
+        case CMD_DISABLE_WRITE:
+            write_enabled = false;
+            break;
+        case CMD_WRITE_STATUS_BYTE1:
+        case CMD_WRITE_STATUS_BYTE2:
+            // we don't model block protection, but the write still consumes the latch.
+            write_enabled = false;
+            break;
+        case CMD_PAGE_PROGRAM:
+            if (write_enabled && page_buffer_used) _spi_flash_model_program();
+            if (page_buffer_used) memset(page_buffer_dirty, 0, sizeof(page_buffer_dirty));
+            write_enabled = false;
+            break;
+        case CMD_SECTOR_ERASE:
+            if (write_enabled && _spi_flash_model_has_address()) _spi_flash_model_erase(SPI_FLASH_MODEL_SECTOR_SIZE, SPI_FLASH_MODEL_SECTOR_ERASE_TIME);
+            write_enabled = false;
+            break;
+        case CMD_BLOCK_ERASE_32K:
+            if (write_enabled && _spi_flash_model_has_address()) _spi_flash_model_erase(32 * 1024, SPI_FLASH_MODEL_BLOCK_32K_ERASE_TIME);
+            write_enabled = false;
+            break;
+        case CMD_BLOCK_ERASE_64K:
+            if (write_enabled && _spi_flash_model_has_address()) _spi_flash_model_erase(64 * 1024, SPI_FLASH_MODEL_BLOCK_64K_ERASE_TIME);
+            write_enabled = false;
+            break;
+        case CMD_CHIP_ERASE:
+            command_address = 0;
+            if (write_enabled) _spi_flash_model_erase(SPI_FLASH_MODEL_SIZE, SPI_FLASH_MODEL_CHIP_ERASE_TIME);
+            write_enabled = false;
+            break;
+        case CMD_POWER_DOWN:
+            powered_down = true;
+            break;
+        case CMD_WAKE:
+            powered_down = false;
+            break;
+        case CMD_ENABLE_RESET:
+            reset_enabled = true;
+            return;
+        case CMD_RESET:
+            if (reset_enabled) {
+                write_enabled = false;
+                busy_until = 0;
+            }
+            break;
+        default:
+            break;
+    }
+    reset_enabled = false;
+}
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_SPI_FLASH_MODEL_H_INCLUDED
+#define _WATCH_SPI_FLASH_MODEL_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Simulated SPI NOR flash that sits behind the simulator's SPI bus, with A3 as its chip select. It decodes the
+// commands in spiflash.h, enforces the write enable latch and page/sector semantics, reports busy for a realistic
+// program or erase time, and persists its contents to SPI_FLASH_MODEL_PATH. Under Emscripten, that path lives in
+// the in-memory file system unless you mount something more durable there. In the host build, each watch in the
+// fleet has its own file, named by SPI_FLASH_MODEL_HOST_PATH with its instance number. Either way, the file is only
+// created once something talks to the flash.
+
+#ifndef SPI_FLASH_MODEL_PATH
+#define SPI_FLASH_MODEL_PATH "spiflash.bin"
+#endif
+
+#ifndef SPI_FLASH_MODEL_HOST_PATH
+#define SPI_FLASH_MODEL_HOST_PATH "spiflash-%u.bin"
+#endif
+
+// modeled on a 16 Mbit Winbond W25Q16JV
+#define SPI_FLASH_MODEL_SIZE (2 * 1024 * 1024)
+#define SPI_FLASH_MODEL_PAGE_SIZE (256)
+#define SPI_FLASH_MODEL_SECTOR_SIZE (4096)
+#define SPI_FLASH_MODEL_JEDEC_ID { 0xEF, 0x40, 0x15 }
+#define SPI_FLASH_MODEL_DEVICE_ID (0x14)
+
+// typical program and erase times from the data sheet, in milliseconds.
+#define SPI_FLASH_MODEL_PAGE_PROGRAM_TIME (0.4)
+#define SPI_FLASH_MODEL_SECTOR_ERASE_TIME (45)
+#define SPI_FLASH_MODEL_BLOCK_32K_ERASE_TIME (120)
+#define SPI_FLASH_MODEL_BLOCK_64K_ERASE_TIME (150)
+#define SPI_FLASH_MODEL_CHIP_ERASE_TIME (5000)
+
+/** Clocks length bytes through the flash: data_out is what the host sends (NULL for 0xFF), data_in receives the reply.
+  * As with the real chip, bytes are ignored (and read back as 0xFF) unless chip select is low.
+  */
+void spi_flash_model_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length);
+
+/// Closes the backing file and frees the model's memory. Everything is saved as it's written, so nothing is lost, and
+/// the next transfer loads it all again as if the chip had just been powered on.
+void spi_flash_model_close(void);
+
+/// Called when the chip select pin changes. Driving it low starts a command; driving it high executes it if needed.
+void spi_flash_model_set_chip_select(bool level);
+
+#endif
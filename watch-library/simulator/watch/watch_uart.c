@@ -25,8 +25,8 @@
 #include "watch_uart.h"
 #include "peripheral_clk_config.h"
 
-static bool tx_enable = false;
-static bool rx_enable = false;
+static WATCH_INSTANCE_LOCAL bool tx_enable = false;
+static WATCH_INSTANCE_LOCAL bool rx_enable = false;
 
 void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud) {
     tx_enable = !!tx_pin;